@@ -0,0 +1,203 @@
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "problems/cvrp/operators/cross_exchange.h"
+#include "problems/cvrp/operators/relocate.h"
+#include "problems/cvrp/operators/two_opt.h"
+#include "structures/vroom/input/input.h"
+#include "structures/vroom/raw_route.h"
+#include "structures/vroom/solution_state.h"
+
+// Micro-benchmark for local search moves evaluation: time spent per
+// move to build an operator, compute its gain and check validity, on
+// a random CVRP with round-robin routes. Usage:
+//
+// ./operators-benchmark [nb_jobs] [nb_vehicles] [nb_repetitions]
+
+namespace {
+
+struct Benchmark {
+  vroom::Input input;
+  std::vector<vroom::RawRoute> routes;
+  std::unique_ptr<vroom::utils::SolutionState> sol_state;
+
+  Benchmark(unsigned nb_jobs, unsigned nb_vehicles) {
+    // Random locations with euclidean durations, using a fixed seed
+    // so that runs are comparable.
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> coord(0, 10000);
+
+    const unsigned nb_locations = nb_jobs + 1;
+    std::vector<std::pair<double, double>> points(nb_locations);
+    for (auto& p : points) {
+      p = {coord(gen), coord(gen)};
+    }
+
+    vroom::Matrix<vroom::UserDuration> durations(nb_locations);
+    for (unsigned i = 0; i < nb_locations; ++i) {
+      for (unsigned j = 0; j < nb_locations; ++j) {
+        durations[i][j] = static_cast<vroom::UserDuration>(
+          std::hypot(points[i].first - points[j].first,
+                     points[i].second - points[j].second));
+      }
+    }
+
+    // Capacity is not binding.
+    vroom::Amount capacity(1);
+    capacity[0] = nb_jobs;
+    for (unsigned v = 0; v < nb_vehicles; ++v) {
+      input.add_vehicle(vroom::Vehicle(v,
+                                       vroom::Location(0),
+                                       vroom::Location(0),
+                                       "car",
+                                       capacity));
+    }
+
+    vroom::Amount delivery(1);
+    delivery[0] = 1;
+    for (unsigned j = 0; j < nb_jobs; ++j) {
+      input.add_job(vroom::Job(j,
+                               vroom::Location(j + 1),
+                               0,
+                               0,
+                               delivery,
+                               vroom::Amount(1)));
+    }
+
+    input.set_durations_matrix("car", std::move(durations));
+    input.prepare(1);
+
+    for (unsigned v = 0; v < nb_vehicles; ++v) {
+      routes.emplace_back(input, v, 1);
+
+      std::vector<vroom::Index> route;
+      for (unsigned j = v; j < nb_jobs; j += nb_vehicles) {
+        route.push_back(j);
+      }
+      routes.back().set_route(input, route);
+    }
+
+    sol_state = std::make_unique<vroom::utils::SolutionState>(input);
+    sol_state->setup(routes);
+  }
+
+  // Evaluate operators built by make for all pairs of routes and all
+  // ranks valid for all operators, then log average time per
+  // evaluation.
+  template <class Make>
+  void run(const std::string& name, unsigned nb_repetitions, Make make) {
+    unsigned long nb_evals = 0;
+    unsigned long nb_valid = 0;
+    vroom::Cost checksum = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (unsigned rep = 0; rep < nb_repetitions; ++rep) {
+      for (vroom::Index s = 0; s < routes.size(); ++s) {
+        for (vroom::Index t = 0; t < routes.size(); ++t) {
+          if (s == t) {
+            continue;
+          }
+          for (vroom::Index s_rank = 0; s_rank + 3u < routes[s].size();
+               ++s_rank) {
+            for (vroom::Index t_rank = 0; t_rank + 3u < routes[t].size();
+                 ++t_rank) {
+              auto op = make(s, s_rank, t, t_rank);
+              if constexpr (requires { op.gain_upper_bound(); }) {
+                checksum += op.gain_upper_bound().cost;
+                if (op.is_valid()) {
+                  ++nb_valid;
+                  checksum += op.gain().cost;
+                }
+              } else {
+                checksum += op.gain().cost;
+                if (op.is_valid()) {
+                  ++nb_valid;
+                }
+              }
+              ++nb_evals;
+            }
+          }
+        }
+      }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const auto ns =
+      std::chrono::duration<double, std::nano>(end - start).count();
+
+    // Checksum is logged so that evaluations are not optimized away.
+    std::cout << name << ": " << ns / nb_evals << " ns/eval (" << nb_evals
+              << " evals, " << nb_valid << " valid, checksum " << checksum
+              << ")" << std::endl;
+  }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const unsigned nb_jobs = (argc > 1) ? std::stoul(argv[1]) : 200;
+  const unsigned nb_vehicles = (argc > 2) ? std::stoul(argv[2]) : 10;
+  const unsigned nb_repetitions = (argc > 3) ? std::stoul(argv[3]) : 20;
+
+  Benchmark b(nb_jobs, nb_vehicles);
+  auto& routes = b.routes;
+  const auto& input = b.input;
+  const auto& sol_state = *b.sol_state;
+
+  b.run("Relocate",
+        nb_repetitions,
+        [&](auto s, auto s_rank, auto t, auto t_rank) {
+          return vroom::cvrp::Relocate(input,
+                                       sol_state,
+                                       routes[s],
+                                       s,
+                                       s_rank,
+                                       routes[t],
+                                       t,
+                                       t_rank);
+        });
+
+  b.run("TwoOpt",
+        nb_repetitions,
+        [&](auto s, auto s_rank, auto t, auto t_rank) {
+          return vroom::cvrp::TwoOpt(input,
+                                     sol_state,
+                                     routes[s],
+                                     s,
+                                     s_rank,
+                                     routes[t],
+                                     t,
+                                     t_rank);
+        });
+
+  b.run("CrossExchange",
+        nb_repetitions,
+        [&](auto s, auto s_rank, auto t, auto t_rank) {
+          return vroom::cvrp::CrossExchange(input,
+                                            sol_state,
+                                            routes[s],
+                                            s,
+                                            s_rank,
+                                            routes[t],
+                                            t,
+                                            t_rank,
+                                            true,
+                                            true);
+        });
+
+  return 0;
+}
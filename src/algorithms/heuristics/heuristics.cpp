@@ -20,12 +20,13 @@ template <class Route>
 inline void seed_route(const Input& input,
                        Route& route,
                        INIT init,
-                       const std::vector<std::vector<Eval>>& evals,
+                       const Matrix<Eval>& evals,
                        std::set<Index>& unassigned,
                        auto job_not_ok) {
   assert(route.empty() && init != INIT::NONE);
 
   const auto v_rank = route.v_rank;
+  const auto v_class = input.vehicle_class(v_rank);
   const auto& vehicle = input.vehicles[v_rank];
 
   // Initialize current route with the "best" valid job.
@@ -63,17 +64,17 @@ inline void seed_route(const Input& input,
       try_validity = (current_deadline < earliest_deadline);
     }
     if (init == INIT::FURTHEST) {
-      try_validity = (furthest_cost < evals[job_rank][v_rank].cost);
+      try_validity = (furthest_cost < evals[job_rank][v_class].cost);
     }
     if (init == INIT::NEAREST) {
-      try_validity = (evals[job_rank][v_rank].cost < nearest_cost);
+      try_validity = (evals[job_rank][v_class].cost < nearest_cost);
     }
 
     if (!try_validity) {
       continue;
     }
 
-    bool is_valid = (vehicle.ok_for_range_bounds(evals[job_rank][v_rank])) &&
+    bool is_valid = (vehicle.ok_for_range_bounds(evals[job_rank][v_class])) &&
                     route.is_valid_addition_for_capacity(input,
                                                          current_job.pickup,
                                                          current_job.delivery,
@@ -113,10 +114,10 @@ inline void seed_route(const Input& input,
                                       : current_job.tws.back().end;
         break;
       case FURTHEST:
-        furthest_cost = evals[job_rank][v_rank].cost;
+        furthest_cost = evals[job_rank][v_class].cost;
         break;
       case NEAREST:
-        nearest_cost = evals[job_rank][v_rank].cost;
+        nearest_cost = evals[job_rank][v_class].cost;
         break;
       }
     }
@@ -529,18 +530,20 @@ Eval basic(const Input& input,
                                          std::vector<Cost>(input.jobs.size()));
 
   // Use own cost for last vehicle regret values.
+  const auto last_class = input.vehicle_class(vehicles_ranks.back());
   for (const auto j : unassigned) {
-    regrets.back()[j] = evals[j][vehicles_ranks.back()].cost;
+    regrets.back()[j] = evals[j][last_class].cost;
   }
 
   for (Index rev_v = 0; rev_v < nb_vehicles - 1; ++rev_v) {
     // Going trough vehicles backward from second to last.
     const auto v = nb_vehicles - 2 - rev_v;
+    const auto v_class = input.vehicle_class(vehicles_ranks[v]);
+    const auto next_class = input.vehicle_class(vehicles_ranks[v + 1]);
 
     bool all_compatible_jobs_later_undoable = true;
     for (const auto j : unassigned) {
-      regrets[v][j] =
-        std::min(regrets[v + 1][j], (evals[j][vehicles_ranks[v + 1]]).cost);
+      regrets[v][j] = std::min(regrets[v + 1][j], evals[j][next_class].cost);
       if (input.vehicle_ok_with_job(vehicles_ranks[v], j) &&
           regrets[v][j] < input.get_cost_upper_bound()) {
         all_compatible_jobs_later_undoable = false;
@@ -554,7 +557,7 @@ Eval basic(const Input& input,
       // the same choices. Using the same approach as with last
       // vehicle.
       for (const auto j : unassigned) {
-        regrets[v][j] = evals[j][vehicles_ranks[v]].cost;
+        regrets[v][j] = evals[j][v_class].cost;
       }
     }
   }
@@ -604,12 +607,13 @@ Eval dynamic_vehicle_choice(const Input& input,
                                             input.get_cost_upper_bound());
     for (const auto j : unassigned) {
       for (const auto v : vehicles_ranks) {
-        if (evals[j][v].cost <= jobs_min_costs[j]) {
+        const auto v_cost = evals[j][input.vehicle_class(v)].cost;
+        if (v_cost <= jobs_min_costs[j]) {
           jobs_second_min_costs[j] = jobs_min_costs[j];
-          jobs_min_costs[j] = evals[j][v].cost;
+          jobs_min_costs[j] = v_cost;
         } else {
-          if (evals[j][v].cost < jobs_second_min_costs[j]) {
-            jobs_second_min_costs[j] = evals[j][v].cost;
+          if (v_cost < jobs_second_min_costs[j]) {
+            jobs_second_min_costs[j] = v_cost;
           }
         }
       }
@@ -621,7 +625,7 @@ Eval dynamic_vehicle_choice(const Input& input,
     std::vector<unsigned> closest_jobs_count(input.vehicles.size(), 0);
     for (const auto j : unassigned) {
       for (const auto v : vehicles_ranks) {
-        if (evals[j][v].cost == jobs_min_costs[j]) {
+        if (evals[j][input.vehicle_class(v)].cost == jobs_min_costs[j]) {
           ++closest_jobs_count[v];
         }
       }
@@ -669,10 +673,11 @@ Eval dynamic_vehicle_choice(const Input& input,
     // empty routes evaluations so do not account for initial routes
     // if any.
     std::vector<Cost> regrets(input.jobs.size(), input.get_cost_upper_bound());
+    const auto v_class = input.vehicle_class(v_rank);
 
     bool all_compatible_jobs_later_undoable = true;
     for (const auto j : unassigned) {
-      if (jobs_min_costs[j] < evals[j][v_rank].cost) {
+      if (jobs_min_costs[j] < evals[j][v_class].cost) {
         regrets[j] = jobs_min_costs[j];
       } else {
         regrets[j] = jobs_second_min_costs[j];
@@ -687,7 +692,7 @@ Eval dynamic_vehicle_choice(const Input& input,
     if (all_compatible_jobs_later_undoable) {
       // Same approach as for basic heuristic.
       for (const auto j : unassigned) {
-        regrets[j] = evals[j][v_rank].cost;
+        regrets[j] = evals[j][v_class].cost;
       }
     }
 
@@ -695,9 +700,9 @@ Eval dynamic_vehicle_choice(const Input& input,
 
     if (current_r.empty() && init != INIT::NONE) {
       auto job_not_ok =
-        [&jobs_min_costs, &evals, v_rank](const Index job_rank) {
+        [&jobs_min_costs, &evals, v_class](const Index job_rank) {
           // One of the remaining vehicles is closest to that job.
-          return jobs_min_costs[job_rank] < evals[job_rank][v_rank].cost;
+          return jobs_min_costs[job_rank] < evals[job_rank][v_class].cost;
         };
 
       seed_route(input, current_r, init, evals, unassigned, job_not_ok);
@@ -718,9 +723,11 @@ void set_route(const Input& input,
   assert(route.empty());
   const auto& vehicle = input.vehicles[route.v_rank];
 
+  const auto& steps = input.initial_steps(route.v_rank);
+
   // Startup load is the sum of deliveries for (single) jobs.
   Amount single_jobs_deliveries(input.zero_amount());
-  for (const auto& step : vehicle.steps) {
+  for (const auto& step : steps) {
     if (step.type == STEP_TYPE::JOB) {
       assert(step.job_type.has_value());
 
@@ -743,9 +750,9 @@ void set_route(const Input& input,
   }
 
   std::vector<Index> job_ranks;
-  job_ranks.reserve(vehicle.steps.size());
+  job_ranks.reserve(steps.size());
   std::unordered_set<Index> expected_delivery_ranks;
-  for (const auto& step : vehicle.steps) {
+  for (const auto& step : steps) {
     if (step.type != STEP_TYPE::JOB) {
       continue;
     }
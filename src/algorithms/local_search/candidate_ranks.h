@@ -0,0 +1,73 @@
+#ifndef CANDIDATE_RANKS_H
+#define CANDIDATE_RANKS_H
+
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "structures/typedefs.h"
+
+namespace vroom::ls {
+
+// Ranks to visit in a route. Unless restricted, e.g. to ranks next
+// to neighbours with granular neighbourhoods, all ranks are
+// candidates.
+class CandidateRanks {
+  bool _restricted{false};
+  std::vector<Index> _ranks;
+
+public:
+  // Restricted candidates have to be added, then sorted.
+  void reset(bool restricted) {
+    _restricted = restricted;
+    _ranks.clear();
+  }
+
+  bool restricted() const {
+    return _restricted;
+  }
+
+  void add(Index rank) {
+    _ranks.push_back(rank);
+  }
+
+  void sort() {
+    std::ranges::sort(_ranks);
+    const auto [first, last] = std::ranges::unique(_ranks);
+    _ranks.erase(first, last);
+  }
+
+  // Lowest candidate rank not lower than rank, if any.
+  unsigned next(unsigned rank) const {
+    if (!_restricted) {
+      return rank;
+    }
+    const auto search = std::ranges::lower_bound(_ranks, rank);
+    return (search == _ranks.end()) ? std::numeric_limits<unsigned>::max()
+                                    : *search;
+  }
+
+  // Highest candidate rank not higher than rank, if any.
+  int previous(int rank) const {
+    if (!_restricted || rank < 0) {
+      return rank;
+    }
+    const auto search =
+      std::ranges::upper_bound(_ranks, static_cast<unsigned>(rank));
+    return (search == _ranks.begin()) ? -1 : *std::prev(search);
+  }
+};
+
+} // namespace vroom::ls
+
+#endif
@@ -76,22 +76,42 @@ LocalSearch<Route,
             TSPFix>::LocalSearch(const Input& input,
                                  std::vector<Route>& sol,
                                  unsigned depth,
-                                 const Timeout& timeout)
+                                 const Timeout& timeout,
+                                 const std::optional<unsigned>& max_moves,
+                                 unsigned nb_threads,
+                                 unsigned seed)
   : _input(input),
     _nb_vehicles(_input.vehicles.size()),
     _depth(depth),
+    _nb_threads(std::max(1u, nb_threads)),
     _deadline(timeout.has_value() ? utils::now() + timeout.value()
                                   : Deadline()),
+    _max_moves(max_moves),
     _all_routes(_nb_vehicles),
     _sol_state(input),
     _sol(sol),
     _best_sol(sol),
-    _best_sol_indicators(_input, _sol) {
+    _best_sol_indicators(_input, _sol),
+    _rng(seed),
+    _thread_pairs(_nb_threads),
+    _thread_stats(_nb_threads),
+    _thread_errors(_nb_threads),
+    _threads_barrier(_nb_threads) {
   // Initialize all route indices.
   std::iota(_all_routes.begin(), _all_routes.end(), 0);
 
   // Setup solution state.
   _sol_state.setup(_sol);
+
+  _best_ops.resize(_nb_vehicles);
+  for (auto& slots : _best_ops) {
+    slots.resize(_nb_vehicles);
+  }
+
+  _workers.reserve(_nb_threads - 1);
+  for (std::size_t t = 1; t < _nb_threads; ++t) {
+    _workers.emplace_back(&LocalSearch::run_worker, this, t);
+  }
 }
 
 template <class Route>
@@ -158,43 +178,63 @@ LocalSearch<Route,
             RouteSplit,
             PriorityReplace,
             TSPFix>::try_job_additions(const std::vector<Index>& routes,
-                                       double regret_coeff) {
-  bool job_added;
+                                       double regret_coeff,
+                                       double noise) {
+  std::unordered_set<Index> modified_vehicles;
 
-  std::vector<std::vector<RouteInsertion>> route_job_insertions;
-  route_job_insertions.reserve(routes.size());
+  if (_sol_state.unassigned.empty()) {
+    return modified_vehicles;
+  }
 
-  for (std::size_t i = 0; i < routes.size(); ++i) {
-    route_job_insertions.emplace_back(_input.jobs.size(),
-                                      RouteInsertion(_input.get_amount_size()));
+  const auto nb_jobs = _input.jobs.size();
+  if (_insertion_versions.empty()) {
+    // Allocated upon first use as all jobs are usually assigned.
+    _insertion_evals.resize(_nb_vehicles * nb_jobs);
+    _insertion_ranks.resize(_nb_vehicles * nb_jobs);
+    _insertion_delivery_ranks.resize(_nb_vehicles * nb_jobs);
+    _insertion_versions.resize(_nb_vehicles * nb_jobs, 0);
+  }
 
-    const auto v = routes[i];
-    const auto fixed_cost =
-      _sol[v].empty() ? _input.vehicles[v].fixed_cost() : 0;
+  auto update_insertion = [&](Index v, Index j) {
+    const auto insertion =
+      compute_best_insertion(_input, _sol_state, j, v, _sol[v]);
+
+    const auto k = v * nb_jobs + j;
+    _insertion_evals[k] = insertion.eval;
+    _insertion_ranks[k] = (_input.jobs[j].type == JOB_TYPE::SINGLE)
+                            ? insertion.single_rank
+                            : insertion.pickup_rank;
+    _insertion_delivery_ranks[k] = insertion.delivery_rank;
+    _insertion_versions[k] = _sol_state.route_versions[v];
+  };
+
+  // Cost of inserting job j in route v, including fixed cost for an
+  // empty route.
+  auto insertion_cost = [&](Index v, Index j) {
+    const auto& eval = _insertion_evals[v * nb_jobs + j];
+    if (eval == NO_EVAL || !_sol[v].empty()) {
+      return eval.cost;
+    }
+    return eval.cost + _input.vehicles[v].fixed_cost();
+  };
 
+  for (const auto v : routes) {
     for (const auto j : _sol_state.unassigned) {
-      if (const auto& current_job = _input.jobs[j];
-          current_job.type == JOB_TYPE::DELIVERY) {
-        continue;
-      }
-      route_job_insertions[i][j] =
-        compute_best_insertion(_input, _sol_state, j, v, _sol[v]);
-
-      if (route_job_insertions[i][j].eval != NO_EVAL) {
-        route_job_insertions[i][j].eval.cost += fixed_cost;
+      if (_input.jobs[j].type != JOB_TYPE::DELIVERY &&
+          _insertion_versions[v * nb_jobs + j] !=
+            _sol_state.route_versions[v]) {
+        update_insertion(v, j);
       }
     }
   }
 
-  std::unordered_set<Index> modified_vehicles;
+  bool job_added;
 
   do {
     Priority best_priority = 0;
-    RouteInsertion best_insertion(_input.get_amount_size());
     double best_cost = std::numeric_limits<double>::max();
     Index best_job_rank = 0;
     Index best_route = 0;
-    std::size_t best_route_idx = 0;
 
     for (const auto j : _sol_state.unassigned) {
       const auto& current_job = _input.jobs[j];
@@ -214,19 +254,19 @@ LocalSearch<Route,
       std::size_t smallest_idx = std::numeric_limits<std::size_t>::max();
 
       for (std::size_t i = 0; i < routes.size(); ++i) {
-        if (route_job_insertions[i][j].eval.cost < smallest) {
+        if (const auto cost = insertion_cost(routes[i], j); cost < smallest) {
           smallest_idx = i;
           second_smallest = smallest;
-          smallest = route_job_insertions[i][j].eval.cost;
-        } else if (route_job_insertions[i][j].eval.cost < second_smallest) {
-          second_smallest = route_job_insertions[i][j].eval.cost;
+          smallest = cost;
+        } else if (cost < second_smallest) {
+          second_smallest = cost;
         }
       }
 
       // Find best route for current job based on cost of addition and
       // regret cost of not adding.
       for (std::size_t i = 0; i < routes.size(); ++i) {
-        if (route_job_insertions[i][j].eval == NO_EVAL) {
+        if (_insertion_evals[routes[i] * nb_jobs + j] == NO_EVAL) {
           continue;
         }
 
@@ -241,8 +281,15 @@ LocalSearch<Route,
         const auto regret_cost =
           (i == smallest_idx) ? second_smallest : smallest;
 
+        auto current_insertion_cost =
+          static_cast<double>(insertion_cost(routes[i], j));
+        if (noise > 0) {
+          current_insertion_cost *=
+            std::uniform_real_distribution<double>(1 - noise, 1 + noise)(_rng);
+        }
+
         const double current_cost =
-          static_cast<double>(route_job_insertions[i][j].eval.cost) -
+          current_insertion_cost -
           regret_coeff * static_cast<double>(regret_cost);
 
         if ((job_priority > best_priority) ||
@@ -250,9 +297,7 @@ LocalSearch<Route,
           best_priority = job_priority;
           best_job_rank = j;
           best_route = routes[i];
-          best_insertion = route_job_insertions[i][j];
           best_cost = current_cost;
-          best_route_idx = i;
         }
       }
     }
@@ -262,28 +307,32 @@ LocalSearch<Route,
     if (job_added) {
       _sol_state.unassigned.erase(best_job_rank);
 
+      const auto k = best_route * nb_jobs + best_job_rank;
       if (const auto& best_job = _input.jobs[best_job_rank];
           best_job.type == JOB_TYPE::SINGLE) {
-        _sol[best_route].add(_input, best_job_rank, best_insertion.single_rank);
+        _sol[best_route].add(_input, best_job_rank, _insertion_ranks[k]);
       } else {
         assert(best_job.type == JOB_TYPE::PICKUP);
+        const auto pickup_rank = _insertion_ranks[k];
+        const auto delivery_rank = _insertion_delivery_ranks[k];
+        const auto delivery =
+          _sol[best_route].delivery_in_range(pickup_rank, delivery_rank);
 
         std::vector<Index> modified_with_pd;
-        modified_with_pd.reserve(best_insertion.delivery_rank -
-                                 best_insertion.pickup_rank + 2);
+        modified_with_pd.reserve(delivery_rank - pickup_rank + 2);
         modified_with_pd.push_back(best_job_rank);
 
-        std::copy(_sol[best_route].route.begin() + best_insertion.pickup_rank,
-                  _sol[best_route].route.begin() + best_insertion.delivery_rank,
+        std::copy(_sol[best_route].route.begin() + pickup_rank,
+                  _sol[best_route].route.begin() + delivery_rank,
                   std::back_inserter(modified_with_pd));
         modified_with_pd.push_back(best_job_rank + 1);
 
         _sol[best_route].replace(_input,
-                                 best_insertion.delivery,
+                                 delivery,
                                  modified_with_pd.begin(),
                                  modified_with_pd.end(),
-                                 best_insertion.pickup_rank,
-                                 best_insertion.delivery_rank);
+                                 pickup_rank,
+                                 delivery_rank);
 
         assert(_sol_state.unassigned.find(best_job_rank + 1) !=
                _sol_state.unassigned.end());
@@ -295,23 +344,9 @@ LocalSearch<Route,
       _sol_state.update_route_eval(_sol[best_route]);
       _sol_state.set_insertion_ranks(_sol[best_route]);
 
-      const auto fixed_cost =
-        _sol[best_route].empty() ? _input.vehicles[best_route].fixed_cost() : 0;
-
       for (const auto j : _sol_state.unassigned) {
-        if (const auto& current_job = _input.jobs[j];
-            current_job.type == JOB_TYPE::DELIVERY) {
-          continue;
-        }
-        route_job_insertions[best_route_idx][j] =
-          compute_best_insertion(_input,
-                                 _sol_state,
-                                 j,
-                                 best_route,
-                                 _sol[best_route]);
-
-        if (route_job_insertions[best_route_idx][j].eval != NO_EVAL) {
-          route_job_insertions[best_route_idx][j].eval.cost += fixed_cost;
+        if (_input.jobs[j].type != JOB_TYPE::DELIVERY) {
+          update_insertion(best_route, j);
         }
       }
     }
@@ -328,6 +363,11 @@ LocalSearch<Route,
     _sol_state.set_edge_gains(_sol[v]);
     _sol_state.set_pd_matching_ranks(_sol[v]);
     _sol_state.set_pd_gains(_sol[v]);
+
+    // Insertions computed after last addition to route remain valid.
+    for (const auto j : _sol_state.unassigned) {
+      _insertion_versions[v * nb_jobs + j] = _sol_state.route_versions[v];
+    }
   }
 
   return modified_vehicles;
@@ -372,52 +412,15 @@ void LocalSearch<Route,
                  SwapStar,
                  RouteSplit,
                  PriorityReplace,
-                 TSPFix>::run_ls_step() {
-  // Store best move involving a pair of routes.
-  std::vector<std::vector<std::unique_ptr<Operator>>> best_ops(_nb_vehicles);
-  for (std::size_t v = 0; v < _nb_vehicles; ++v) {
-    best_ops[v] = std::vector<std::unique_ptr<Operator>>(_nb_vehicles);
-  }
-
-  // List of source/target pairs we need to test (all related vehicles
-  // at first).
-  std::vector<std::pair<Index, Index>> s_t_pairs;
-  s_t_pairs.reserve(_nb_vehicles * _nb_vehicles);
-
-  for (unsigned s_v = 0; s_v < _nb_vehicles; ++s_v) {
-    for (unsigned t_v = 0; t_v < _nb_vehicles; ++t_v) {
-      if (_input.vehicle_ok_with_vehicle(s_v, t_v)) {
-        s_t_pairs.emplace_back(s_v, t_v);
-      }
-    }
-  }
+                 TSPFix>::evaluate_priority_moves(const RoutePairs& s_t_pairs,
+                                                   OperatorsStats& stats) {
+  if (_input.has_jobs()) {
+    // Move(s) that don't make sense for shipment-only instances.
 
-  // Store best gain for matching move.
-  std::vector<std::vector<Eval>> best_gains(_nb_vehicles,
-                                            std::vector<Eval>(_nb_vehicles,
-                                                              Eval()));
-
-  // Store best priority increase and number of assigned tasks for use
-  // with operators involving a single route and unassigned jobs
-  // (UnassignedExchange and PriorityReplace).
-  std::vector<Priority> best_priorities(_nb_vehicles, 0);
-  std::vector<unsigned> best_removals(_nb_vehicles,
-                                      std::numeric_limits<unsigned>::max());
-
-  // Dummy init to enter first loop.
-  Eval best_gain(static_cast<Cost>(1));
-  Priority best_priority = 0;
-  auto best_removal = std::numeric_limits<unsigned>::max();
-
-  while (best_gain.cost > 0 || best_priority > 0) {
-    if (_deadline.has_value() && _deadline.value() < utils::now()) {
-      break;
-    }
+    // UnassignedExchange stuff
+    if (!_skipped_operators[OperatorName::UnassignedExchange]) {
+      const auto start = utils::now();
 
-    if (_input.has_jobs()) {
-      // Move(s) that don't make sense for shipment-only instances.
-
-      // UnassignedExchange stuff
       for (const Index u : _sol_state.unassigned) {
         if (_input.jobs[u].type != JOB_TYPE::SINGLE) {
           continue;
@@ -454,7 +457,7 @@ void LocalSearch<Route,
 
             const Priority priority_gain = u_priority - current_job.priority;
 
-            if (best_priorities[source] <= priority_gain) {
+            if (_best_priorities[source] <= priority_gain) {
               if (!(u_delivery <= delivery_margin + current_job.delivery) ||
                   !(u_pickup <= pickup_margin + current_job.pickup)) {
                 continue;
@@ -503,18 +506,17 @@ void LocalSearch<Route,
                                      u);
 
                 const bool better_if_valid =
-                  (best_priorities[source] < priority_gain) ||
-                  (best_priorities[source] == priority_gain &&
-                   best_gains[source][source] < r.gain());
+                  (_best_priorities[source] < priority_gain) ||
+                  (_best_priorities[source] == priority_gain &&
+                   _best_gains[source][source] < r.gain());
 
                 if (better_if_valid && r.is_valid()) {
-                  best_priorities[source] = priority_gain;
-                  best_removals[source] = 0;
+                  _best_priorities[source] = priority_gain;
+                  _best_removals[source] = 0;
                   // This may potentially define a negative value as
                   // best gain in case priority_gain is non-zero.
-                  best_gains[source][source] = r.gain();
-                  best_ops[source][source] =
-                    std::make_unique<UnassignedExchange>(r);
+                  _best_gains[source][source] = r.gain();
+                  set_best_op(source, source, r, stats);
                 }
               }
             }
@@ -522,7 +524,13 @@ void LocalSearch<Route,
         }
       }
 
-      // PriorityReplace stuff
+      stats[OperatorName::UnassignedExchange].add_run(s_t_pairs.size(), start);
+    }
+
+    // PriorityReplace stuff
+    if (!_skipped_operators[OperatorName::PriorityReplace]) {
+      const auto start = utils::now();
+
       for (const Index u : _sol_state.unassigned) {
         if (_input.jobs[u].type != JOB_TYPE::SINGLE) {
           continue;
@@ -592,7 +600,7 @@ void LocalSearch<Route,
             std::max(begin_priority_gain, end_priority_gain);
 
           if (best_current_priority > 0 &&
-              best_priorities[source] <= best_current_priority) {
+              _best_priorities[source] <= best_current_priority) {
             PriorityReplace r(_input,
                               _sol_state,
                               _sol_state.unassigned,
@@ -601,33 +609,82 @@ void LocalSearch<Route,
                               fwd_last_rank,
                               bwd_first_rank,
                               u,
-                              best_priorities[source]);
+                              _best_priorities[source]);
 
             if (r.is_valid()) {
               const auto priority_gain = r.priority_gain();
               const unsigned removal = _sol[source].size() - r.assigned();
               const auto gain = r.gain();
-              if (std::tie(best_priorities[source],
+              if (std::tie(_best_priorities[source],
                            removal,
-                           best_gains[source][source]) <
-                  std::tie(priority_gain, best_removals[source], gain)) {
-                best_priorities[source] = priority_gain;
-                best_removals[source] = removal;
+                           _best_gains[source][source]) <
+                  std::tie(priority_gain, _best_removals[source], gain)) {
+                _best_priorities[source] = priority_gain;
+                _best_removals[source] = removal;
                 // This may potentially define a negative value as best
                 // gain.
-                best_gains[source][source] = r.gain();
-                best_ops[source][source] = std::make_unique<PriorityReplace>(r);
+                _best_gains[source][source] = r.gain();
+                set_best_op(source, source, r, stats);
               }
             }
           }
         }
       }
+
+      stats[OperatorName::PriorityReplace].add_run(s_t_pairs.size(), start);
     }
+  }
+}
+
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::evaluate_moves(const RoutePairs& s_t_pairs,
+                                          OperatorsStats& stats) {
+  // CrossExchange stuff
+  if (!_skipped_operators[OperatorName::CrossExchange]) {
+    const auto start = utils::now();
+    CandidateRanks t_ranks;
 
-    // CrossExchange stuff
     for (const auto& [source, target] : s_t_pairs) {
       if (target <= source || // This operator is symmetric.
-          best_priorities[source] > 0 || best_priorities[target] > 0 ||
+          _best_priorities[source] > 0 || _best_priorities[target] > 0 ||
           _sol[source].size() < 2 || _sol[target].size() < 2 ||
           (_input.all_locations_have_coords() &&
            _input.vehicles[source].has_same_profile(_input.vehicles[target]) &&
@@ -685,7 +742,38 @@ void LocalSearch<Route,
         begin_t_rank = std::max(begin_t_rank, begin_s_next);
         begin_t_rank = (begin_t_rank > 1) ? begin_t_rank - 2 : 0;
 
-        for (unsigned t_rank = begin_t_rank; t_rank < end_t_rank; ++t_rank) {
+        // With granular neighbourhoods, only visit ranks where one of
+        // the exchanged edges ends up next to a neighbour, unless an
+        // edge replaces a whole route.
+        t_ranks.reset(_input.has_granularity() && _sol[source].size() > 2 &&
+                      _sol[target].size() > 2);
+        if (t_ranks.restricted()) {
+          const auto& s_route = _sol[source].route;
+          add_neighbour_ranks(t_ranks, target, s_job_rank, target, {-1, 2});
+          add_neighbour_ranks(t_ranks,
+                              target,
+                              s_next_job_rank,
+                              target,
+                              {-1, 2});
+          if (s_rank > 0) {
+            add_neighbour_ranks(t_ranks,
+                                source,
+                                s_route[s_rank - 1],
+                                target,
+                                {0, 1});
+          }
+          if (s_rank + 2 < s_route.size()) {
+            add_neighbour_ranks(t_ranks,
+                                source,
+                                s_route[s_rank + 2],
+                                target,
+                                {0, 1});
+          }
+          t_ranks.sort();
+        }
+
+        for (unsigned t_rank = t_ranks.next(begin_t_rank); t_rank < end_t_rank;
+             t_rank = t_ranks.next(t_rank + 1)) {
           const auto t_job_rank = _sol[target].route[t_rank];
           const auto t_next_job_rank = _sol[target].route[t_rank + 1];
 
@@ -750,21 +838,28 @@ void LocalSearch<Route,
                           !is_s_pickup,
                           !is_t_pickup);
 
-          auto& current_best = best_gains[source][target];
+          auto& current_best = _best_gains[source][target];
           if (current_best < r.gain_upper_bound() && r.is_valid() &&
               current_best < r.gain()) {
             current_best = r.gain();
-            best_ops[source][target] = std::make_unique<CrossExchange>(r);
+            set_best_op(source, target, r, stats);
           }
         }
       }
     }
 
-    if (_input.has_jobs()) {
-      // MixedExchange stuff
+    stats[OperatorName::CrossExchange].add_run(s_t_pairs.size(), start);
+  }
+
+  if (_input.has_jobs()) {
+    // MixedExchange stuff
+    if (!_skipped_operators[OperatorName::MixedExchange]) {
+      const auto start = utils::now();
+      CandidateRanks t_ranks;
+
       for (const auto& [source, target] : s_t_pairs) {
-        if (source == target || best_priorities[source] > 0 ||
-            best_priorities[target] > 0 || _sol[source].size() == 0 ||
+        if (source == target || _best_priorities[source] > 0 ||
+            _best_priorities[target] > 0 || _sol[source].size() == 0 ||
             _sol[target].size() < 2 ||
             (_input.all_locations_have_coords() &&
              _input.vehicles[source].has_same_profile(
@@ -803,7 +898,34 @@ void LocalSearch<Route,
             _sol_state.insertion_ranks_begin[target][s_job_rank];
           begin_t_rank = (begin_t_rank > 1) ? begin_t_rank - 2 : 0;
 
-          for (unsigned t_rank = begin_t_rank; t_rank < end_t_rank; ++t_rank) {
+          // With granular neighbourhoods, only visit ranks where
+          // exchanged job or edge ends up next to a neighbour, unless
+          // it replaces a whole route.
+          t_ranks.reset(_input.has_granularity() &&
+                        _sol[source].size() > 1 && _sol[target].size() > 2);
+          if (t_ranks.restricted()) {
+            const auto& s_route = _sol[source].route;
+            add_neighbour_ranks(t_ranks, target, s_job_rank, target, {-1, 2});
+            if (s_rank > 0) {
+              add_neighbour_ranks(t_ranks,
+                                  source,
+                                  s_route[s_rank - 1],
+                                  target,
+                                  {0, 1});
+            }
+            if (s_rank + 1 < s_route.size()) {
+              add_neighbour_ranks(t_ranks,
+                                  source,
+                                  s_route[s_rank + 1],
+                                  target,
+                                  {0, 1});
+            }
+            t_ranks.sort();
+          }
+
+          for (unsigned t_rank = t_ranks.next(begin_t_rank);
+               t_rank < end_t_rank;
+               t_rank = t_ranks.next(t_rank + 1)) {
             if (!_input.vehicle_ok_with_job(source,
                                             _sol[target].route[t_rank]) ||
                 !_input.vehicle_ok_with_job(source,
@@ -813,6 +935,7 @@ void LocalSearch<Route,
 
             const auto t_job_rank = _sol[target].route[t_rank];
             const auto t_next_job_rank = _sol[target].route[t_rank + 1];
+
             const auto& job_t_type = _input.jobs[t_job_rank].type;
 
             const bool both_t_single =
@@ -863,21 +986,28 @@ void LocalSearch<Route,
                             t_rank,
                             !is_t_pickup);
 
-            auto& current_best = best_gains[source][target];
+            auto& current_best = _best_gains[source][target];
             if (current_best < r.gain_upper_bound() && r.is_valid() &&
                 current_best < r.gain()) {
               current_best = r.gain();
-              best_ops[source][target] = std::make_unique<MixedExchange>(r);
+              set_best_op(source, target, r, stats);
             }
           }
         }
       }
+
+      stats[OperatorName::MixedExchange].add_run(s_t_pairs.size(), start);
     }
+  }
+
+  // TwoOpt stuff
+  if (!_skipped_operators[OperatorName::TwoOpt]) {
+    const auto start = utils::now();
+    CandidateRanks t_ranks;
 
-    // TwoOpt stuff
     for (const auto& [source, target] : s_t_pairs) {
       if (target <= source || // This operator is symmetric.
-          best_priorities[source] > 0 || best_priorities[target] > 0 ||
+          _best_priorities[source] > 0 || _best_priorities[target] > 0 ||
           (_input.all_locations_have_coords() &&
            _input.vehicles[source].has_same_profile(_input.vehicles[target]) &&
            !_sol_state.route_bbox[source].intersects(
@@ -928,7 +1058,25 @@ void LocalSearch<Route,
                        .weak_insertion_ranks_end[target][s_next_job_rank]);
         }
 
-        for (int t_rank = end_t_rank - 1; t_rank >= first_t_rank; --t_rank) {
+        // With granular neighbourhoods, only visit ranks where a new
+        // edge links neighbours.
+        t_ranks.reset(_input.has_granularity());
+        if (t_ranks.restricted()) {
+          const auto& s_route = _sol[source].route;
+          add_neighbour_ranks(t_ranks, source, s_route[s_rank], target, {1});
+          if (s_rank + 1 < s_route.size()) {
+            add_neighbour_ranks(t_ranks,
+                                target,
+                                s_route[s_rank + 1],
+                                target,
+                                {0});
+          }
+          t_ranks.sort();
+        }
+
+        for (int t_rank = t_ranks.previous(end_t_rank - 1);
+             t_rank >= first_t_rank;
+             t_rank = t_ranks.previous(t_rank - 1)) {
           if (_sol[target].has_pending_delivery_after_rank(t_rank)) {
             continue;
           }
@@ -984,18 +1132,25 @@ void LocalSearch<Route,
                    target,
                    t_rank);
 
-          if (best_gains[source][target] < r.gain() && r.is_valid()) {
-            best_gains[source][target] = r.gain();
-            best_ops[source][target] = std::make_unique<TwoOpt>(r);
+          if (_best_gains[source][target] < r.gain() && r.is_valid()) {
+            _best_gains[source][target] = r.gain();
+            set_best_op(source, target, r, stats);
           }
         }
       }
     }
 
-    // ReverseTwoOpt stuff
+    stats[OperatorName::TwoOpt].add_run(s_t_pairs.size(), start);
+  }
+
+  // ReverseTwoOpt stuff
+  if (!_skipped_operators[OperatorName::ReverseTwoOpt]) {
+    const auto start = utils::now();
+    CandidateRanks t_ranks;
+
     for (const auto& [source, target] : s_t_pairs) {
-      if (source == target || best_priorities[source] > 0 ||
-          best_priorities[target] > 0 ||
+      if (source == target || _best_priorities[source] > 0 ||
+          _best_priorities[target] > 0 ||
           (_input.all_locations_have_coords() &&
            _input.vehicles[source].has_same_profile(_input.vehicles[target]) &&
            !_sol_state.route_bbox[source].intersects(
@@ -1037,9 +1192,25 @@ void LocalSearch<Route,
           }
         }
 
-        for (unsigned t_rank = begin_t_rank;
+        // With granular neighbourhoods, only visit ranks where a new
+        // edge links neighbours.
+        t_ranks.reset(_input.has_granularity());
+        if (t_ranks.restricted()) {
+          const auto& s_route = _sol[source].route;
+          add_neighbour_ranks(t_ranks, source, s_route[s_rank], target, {0});
+          if (s_rank + 1 < s_route.size()) {
+            add_neighbour_ranks(t_ranks,
+                                target,
+                                s_route[s_rank + 1],
+                                target,
+                                {1});
+          }
+          t_ranks.sort();
+        }
+
+        for (unsigned t_rank = t_ranks.next(begin_t_rank);
              t_rank < _sol_state.fwd_skill_rank[target][source];
-             ++t_rank) {
+             t_rank = t_ranks.next(t_rank + 1)) {
           if (_sol[target].has_pickup_up_to_rank(t_rank)) {
             continue;
           }
@@ -1084,21 +1255,28 @@ void LocalSearch<Route,
                           target,
                           t_rank);
 
-          if (best_gains[source][target] < r.gain() && r.is_valid()) {
-            best_gains[source][target] = r.gain();
-            best_ops[source][target] = std::make_unique<ReverseTwoOpt>(r);
+          if (_best_gains[source][target] < r.gain() && r.is_valid()) {
+            _best_gains[source][target] = r.gain();
+            set_best_op(source, target, r, stats);
           }
         }
       }
     }
 
-    if (_input.has_jobs()) {
-      // Move(s) that don't make sense for shipment-only instances.
+    stats[OperatorName::ReverseTwoOpt].add_run(s_t_pairs.size(), start);
+  }
+
+  if (_input.has_jobs()) {
+    // Move(s) that don't make sense for shipment-only instances.
+
+    // Relocate stuff
+    if (!_skipped_operators[OperatorName::Relocate]) {
+      const auto start = utils::now();
+      CandidateRanks t_ranks;
 
-      // Relocate stuff
       for (const auto& [source, target] : s_t_pairs) {
-        if (source == target || best_priorities[source] > 0 ||
-            best_priorities[target] > 0 || _sol[source].size() == 0) {
+        if (source == target || _best_priorities[source] > 0 ||
+            _best_priorities[target] > 0 || _sol[source].size() == 0) {
           continue;
         }
 
@@ -1111,7 +1289,7 @@ void LocalSearch<Route,
 
         for (unsigned s_rank = 0; s_rank < _sol[source].size(); ++s_rank) {
           if (_sol_state.node_gains[source][s_rank] <=
-              best_gains[source][target]) {
+              _best_gains[source][target]) {
             // Except if addition cost in target route is negative
             // (!!), overall gain can't exceed current known best
             // gain.
@@ -1134,10 +1312,18 @@ void LocalSearch<Route,
             continue;
           }
 
-          for (unsigned t_rank =
-                 _sol_state.insertion_ranks_begin[target][s_job_rank];
+          // With granular neighbourhoods, only visit ranks next to a
+          // neighbour, unless target route is empty.
+          t_ranks.reset(_input.has_granularity() && !_sol[target].empty());
+          if (t_ranks.restricted()) {
+            add_neighbour_ranks(t_ranks, target, s_job_rank, target, {0, -1});
+            t_ranks.sort();
+          }
+
+          for (unsigned t_rank = t_ranks.next(
+                 _sol_state.insertion_ranks_begin[target][s_job_rank]);
                t_rank < _sol_state.insertion_ranks_end[target][s_job_rank];
-               ++t_rank) {
+               t_rank = t_ranks.next(t_rank + 1)) {
             Relocate r(_input,
                        _sol_state,
                        _sol[source],
@@ -1147,18 +1333,25 @@ void LocalSearch<Route,
                        target,
                        t_rank);
 
-            if (best_gains[source][target] < r.gain() && r.is_valid()) {
-              best_gains[source][target] = r.gain();
-              best_ops[source][target] = std::make_unique<Relocate>(r);
+            if (_best_gains[source][target] < r.gain() && r.is_valid()) {
+              _best_gains[source][target] = r.gain();
+              set_best_op(source, target, r, stats);
             }
           }
         }
       }
 
-      // OrOpt stuff
+      stats[OperatorName::Relocate].add_run(s_t_pairs.size(), start);
+    }
+
+    // OrOpt stuff
+    if (!_skipped_operators[OperatorName::OrOpt]) {
+      const auto start = utils::now();
+      CandidateRanks t_ranks;
+
       for (const auto& [source, target] : s_t_pairs) {
-        if (source == target || best_priorities[source] > 0 ||
-            best_priorities[target] > 0 || _sol[source].size() < 2) {
+        if (source == target || _best_priorities[source] > 0 ||
+            _best_priorities[target] > 0 || _sol[source].size() < 2) {
           continue;
         }
 
@@ -1171,7 +1364,7 @@ void LocalSearch<Route,
 
         for (unsigned s_rank = 0; s_rank < _sol[source].size() - 1; ++s_rank) {
           if (_sol_state.edge_gains[source][s_rank] <=
-              best_gains[source][target]) {
+              _best_gains[source][target]) {
             // Except if addition cost in route target is negative
             // (!!), overall gain can't exceed current known best gain.
             continue;
@@ -1209,8 +1402,23 @@ void LocalSearch<Route,
           const auto insertion_end =
             std::min(_sol_state.insertion_ranks_end[target][s_job_rank],
                      _sol_state.insertion_ranks_end[target][s_next_job_rank]);
-          for (unsigned t_rank = insertion_start; t_rank < insertion_end;
-               ++t_rank) {
+
+          // With granular neighbourhoods, only visit ranks next to a
+          // neighbour, unless target route is empty.
+          t_ranks.reset(_input.has_granularity() && !_sol[target].empty());
+          if (t_ranks.restricted()) {
+            add_neighbour_ranks(t_ranks, target, s_job_rank, target, {0, -1});
+            add_neighbour_ranks(t_ranks,
+                                target,
+                                s_next_job_rank,
+                                target,
+                                {0, -1});
+            t_ranks.sort();
+          }
+
+          for (unsigned t_rank = t_ranks.next(insertion_start);
+               t_rank < insertion_end;
+               t_rank = t_ranks.next(t_rank + 1)) {
             OrOpt r(_input,
                     _sol_state,
                     _sol[source],
@@ -1220,37 +1428,49 @@ void LocalSearch<Route,
                     target,
                     t_rank);
 
-            auto& current_best = best_gains[source][target];
+            auto& current_best = _best_gains[source][target];
             if (current_best < r.gain_upper_bound() && r.is_valid() &&
                 current_best < r.gain()) {
               current_best = r.gain();
-              best_ops[source][target] = std::make_unique<OrOpt>(r);
+              set_best_op(source, target, r, stats);
             }
           }
         }
       }
+
+      stats[OperatorName::OrOpt].add_run(s_t_pairs.size(), start);
     }
+  }
+
+  // TSPFix stuff
+  if (_input.apply_TSPFix() && !_input.has_shipments()) {
+    if (!_skipped_operators[OperatorName::TSPFix]) {
+      const auto start = utils::now();
 
-    // TSPFix stuff
-    if (_input.apply_TSPFix() && !_input.has_shipments()) {
       for (const auto& [source, target] : s_t_pairs) {
-        if (target != source || best_priorities[source] > 0 ||
+        if (target != source || _best_priorities[source] > 0 ||
             _sol[source].size() < 2) {
           continue;
         }
 
         TSPFix op(_input, _sol_state, _sol[source], source);
 
-        if (best_gains[source][target] < op.gain() && op.is_valid()) {
-          best_gains[source][target] = op.gain();
-          best_ops[source][target] = std::make_unique<TSPFix>(op);
+        if (_best_gains[source][target] < op.gain() && op.is_valid()) {
+          _best_gains[source][target] = op.gain();
+          set_best_op(source, target, op, stats);
         }
       }
+
+      stats[OperatorName::TSPFix].add_run(s_t_pairs.size(), start);
     }
+  }
+
+  // IntraExchange stuff
+  if (!_skipped_operators[OperatorName::IntraExchange]) {
+    const auto start = utils::now();
 
-    // IntraExchange stuff
     for (const auto& [source, target] : s_t_pairs) {
-      if (source != target || best_priorities[source] > 0 ||
+      if (source != target || _best_priorities[source] > 0 ||
           _sol[source].size() < 3) {
         continue;
       }
@@ -1290,18 +1510,24 @@ void LocalSearch<Route,
                           s_rank,
                           t_rank);
 
-          if (best_gains[source][source] < r.gain() && r.is_valid()) {
-            best_gains[source][source] = r.gain();
-            best_ops[source][source] = std::make_unique<IntraExchange>(r);
+          if (_best_gains[source][source] < r.gain() && r.is_valid()) {
+            _best_gains[source][source] = r.gain();
+            set_best_op(source, source, r, stats);
           }
         }
       }
     }
 
-    // IntraCrossExchange stuff
+    stats[OperatorName::IntraExchange].add_run(s_t_pairs.size(), start);
+  }
+
+  // IntraCrossExchange stuff
+  if (!_skipped_operators[OperatorName::IntraCrossExchange]) {
+    const auto start = utils::now();
+
     constexpr unsigned min_intra_cross_exchange_size = 5;
     for (const auto& [source, target] : s_t_pairs) {
-      if (source != target || best_priorities[source] > 0 ||
+      if (source != target || _best_priorities[source] > 0 ||
           _sol[source].size() < min_intra_cross_exchange_size) {
         continue;
       }
@@ -1359,19 +1585,25 @@ void LocalSearch<Route,
                                !is_s_pickup,
                                !is_t_pickup);
 
-          auto& current_best = best_gains[source][target];
+          auto& current_best = _best_gains[source][target];
           if (current_best < r.gain_upper_bound() && r.is_valid() &&
               current_best < r.gain()) {
             current_best = r.gain();
-            best_ops[source][source] = std::make_unique<IntraCrossExchange>(r);
+            set_best_op(source, source, r, stats);
           }
         }
       }
     }
 
-    // IntraMixedExchange stuff
+    stats[OperatorName::IntraCrossExchange].add_run(s_t_pairs.size(), start);
+  }
+
+  // IntraMixedExchange stuff
+  if (!_skipped_operators[OperatorName::IntraMixedExchange]) {
+    const auto start = utils::now();
+
     for (const auto& [source, target] : s_t_pairs) {
-      if (source != target || best_priorities[source] > 0 ||
+      if (source != target || _best_priorities[source] > 0 ||
           _sol[source].size() < 4) {
         continue;
       }
@@ -1426,26 +1658,32 @@ void LocalSearch<Route,
                                s_rank,
                                t_rank,
                                !is_t_pickup);
-          auto& current_best = best_gains[source][target];
+          auto& current_best = _best_gains[source][target];
           if (current_best < r.gain_upper_bound() && r.is_valid() &&
               current_best < r.gain()) {
             current_best = r.gain();
-            best_ops[source][source] = std::make_unique<IntraMixedExchange>(r);
+            set_best_op(source, source, r, stats);
           }
         }
       }
     }
 
-    // IntraRelocate stuff
+    stats[OperatorName::IntraMixedExchange].add_run(s_t_pairs.size(), start);
+  }
+
+  // IntraRelocate stuff
+  if (!_skipped_operators[OperatorName::IntraRelocate]) {
+    const auto start = utils::now();
+
     for (const auto& [source, target] : s_t_pairs) {
-      if (source != target || best_priorities[source] > 0 ||
+      if (source != target || _best_priorities[source] > 0 ||
           _sol[source].size() < 2) {
         continue;
       }
 
       for (unsigned s_rank = 0; s_rank < _sol[source].size(); ++s_rank) {
         if (_sol_state.node_gains[source][s_rank] <=
-            best_gains[source][source]) {
+            _best_gains[source][source]) {
           // Except if addition cost in route is negative (!!),
           // overall gain can't exceed current known best gain.
           continue;
@@ -1486,17 +1724,23 @@ void LocalSearch<Route,
                           s_rank,
                           t_rank);
 
-          if (best_gains[source][source] < r.gain() && r.is_valid()) {
-            best_gains[source][source] = r.gain();
-            best_ops[source][source] = std::make_unique<IntraRelocate>(r);
+          if (_best_gains[source][source] < r.gain() && r.is_valid()) {
+            _best_gains[source][source] = r.gain();
+            set_best_op(source, source, r, stats);
           }
         }
       }
     }
 
-    // IntraOrOpt stuff
+    stats[OperatorName::IntraRelocate].add_run(s_t_pairs.size(), start);
+  }
+
+  // IntraOrOpt stuff
+  if (!_skipped_operators[OperatorName::IntraOrOpt]) {
+    const auto start = utils::now();
+
     for (const auto& [source, target] : s_t_pairs) {
-      if (source != target || best_priorities[source] > 0 ||
+      if (source != target || _best_priorities[source] > 0 ||
           _sol[source].size() < 4) {
         continue;
       }
@@ -1518,7 +1762,7 @@ void LocalSearch<Route,
 
         if (is_pickup) {
           if (_sol_state.pd_gains[source][s_rank] <=
-              best_gains[source][source]) {
+              _best_gains[source][source]) {
             // Except if addition cost in route is negative (!!),
             // overall gain can't exceed current known best gain.
             continue;
@@ -1526,7 +1770,7 @@ void LocalSearch<Route,
         } else {
           // Regular single job.
           if (_sol_state.edge_gains[source][s_rank] <=
-              best_gains[source][source]) {
+              _best_gains[source][source]) {
             // Except if addition cost in route is negative (!!),
             // overall gain can't exceed current known best gain.
             continue;
@@ -1558,19 +1802,25 @@ void LocalSearch<Route,
                        s_rank,
                        t_rank,
                        !is_pickup);
-          auto& current_best = best_gains[source][target];
+          auto& current_best = _best_gains[source][target];
           if (current_best < r.gain_upper_bound() && r.is_valid() &&
               current_best < r.gain()) {
             current_best = r.gain();
-            best_ops[source][source] = std::make_unique<IntraOrOpt>(r);
+            set_best_op(source, source, r, stats);
           }
         }
       }
     }
 
-    // IntraTwoOpt stuff
+    stats[OperatorName::IntraOrOpt].add_run(s_t_pairs.size(), start);
+  }
+
+  // IntraTwoOpt stuff
+  if (!_skipped_operators[OperatorName::IntraTwoOpt]) {
+    const auto start = utils::now();
+
     for (const auto& [source, target] : s_t_pairs) {
-      if (source != target || best_priorities[source] > 0 ||
+      if (source != target || _best_priorities[source] > 0 ||
           _sol[source].size() < 4) {
         continue;
       }
@@ -1589,22 +1839,28 @@ void LocalSearch<Route,
                         source,
                         s_rank,
                         t_rank);
-          auto& current_best = best_gains[source][target];
+          auto& current_best = _best_gains[source][target];
           if (current_best < r.gain() && r.is_valid()) {
             current_best = r.gain();
-            best_ops[source][source] = std::make_unique<IntraTwoOpt>(r);
+            set_best_op(source, source, r, stats);
           }
         }
       }
     }
 
-    if (_input.has_shipments()) {
-      // Move(s) that don't make sense for job-only instances.
+    stats[OperatorName::IntraTwoOpt].add_run(s_t_pairs.size(), start);
+  }
+
+  if (_input.has_shipments()) {
+    // Move(s) that don't make sense for job-only instances.
+
+    // PDShift stuff
+    if (!_skipped_operators[OperatorName::PDShift]) {
+      const auto start = utils::now();
 
-      // PDShift stuff
       for (const auto& [source, target] : s_t_pairs) {
-        if (source == target || best_priorities[source] > 0 ||
-            best_priorities[target] > 0 || _sol[source].size() == 0) {
+        if (source == target || _best_priorities[source] > 0 ||
+            _best_priorities[target] > 0 || _sol[source].size() == 0) {
           // Don't try to put things from an empty vehicle.
           continue;
         }
@@ -1632,7 +1888,7 @@ void LocalSearch<Route,
           }
 
           if (_sol_state.pd_gains[source][s_p_rank] <=
-              best_gains[source][target]) {
+              _best_gains[source][target]) {
             // Except if addition cost in target route is negative
             // (!!), overall gain can't exceed current known best
             // gain.
@@ -1655,22 +1911,28 @@ void LocalSearch<Route,
                       s_d_rank,
                       _sol[target],
                       target,
-                      best_gains[source][target]);
+                      _best_gains[source][target]);
 
-          if (best_gains[source][target] < pdr.gain() && pdr.is_valid()) {
-            best_gains[source][target] = pdr.gain();
-            best_ops[source][target] = std::make_unique<PDShift>(pdr);
+          if (_best_gains[source][target] < pdr.gain() && pdr.is_valid()) {
+            _best_gains[source][target] = pdr.gain();
+            set_best_op(source, target, pdr, stats);
           }
         }
       }
+
+      stats[OperatorName::PDShift].add_run(s_t_pairs.size(), start);
     }
+  }
+
+  if (!_input.has_homogeneous_locations() ||
+      !_input.has_homogeneous_profiles() || !_input.has_homogeneous_costs()) {
+    // RouteExchange stuff
+    if (!_skipped_operators[OperatorName::RouteExchange]) {
+      const auto start = utils::now();
 
-    if (!_input.has_homogeneous_locations() ||
-        !_input.has_homogeneous_profiles() || !_input.has_homogeneous_costs()) {
-      // RouteExchange stuff
       for (const auto& [source, target] : s_t_pairs) {
-        if (target <= source || best_priorities[source] > 0 ||
-            best_priorities[target] > 0 ||
+        if (target <= source || _best_priorities[source] > 0 ||
+            _best_priorities[target] > 0 ||
             (_sol[source].size() == 0 && _sol[target].size() == 0) ||
             _sol_state.bwd_skill_rank[source][target] > 0 ||
             _sol_state.bwd_skill_rank[target][source] > 0) {
@@ -1706,18 +1968,24 @@ void LocalSearch<Route,
                          _sol[target],
                          target);
 
-        if (best_gains[source][target] < re.gain() && re.is_valid()) {
-          best_gains[source][target] = re.gain();
-          best_ops[source][target] = std::make_unique<RouteExchange>(re);
+        if (_best_gains[source][target] < re.gain() && re.is_valid()) {
+          _best_gains[source][target] = re.gain();
+          set_best_op(source, target, re, stats);
         }
       }
+
+      stats[OperatorName::RouteExchange].add_run(s_t_pairs.size(), start);
     }
+  }
+
+  if (_input.has_jobs()) {
+    // SwapStar stuff
+    if (!_skipped_operators[OperatorName::SwapStar]) {
+      const auto start = utils::now();
 
-    if (_input.has_jobs()) {
-      // SwapStar stuff
       for (const auto& [source, target] : s_t_pairs) {
         if (target <= source || // This operator is symmetric.
-            best_priorities[source] > 0 || best_priorities[target] > 0 ||
+            _best_priorities[source] > 0 || _best_priorities[target] > 0 ||
             _sol[source].size() == 0 || _sol[target].size() == 0 ||
             !_input.vehicle_ok_with_vehicle(source, target) ||
             (_input.all_locations_have_coords() &&
@@ -1734,18 +2002,24 @@ void LocalSearch<Route,
                    source,
                    _sol[target],
                    target,
-                   best_gains[source][target]);
+                   _best_gains[source][target]);
 
-        if (best_gains[source][target] < r.gain()) {
-          best_gains[source][target] = r.gain();
-          best_ops[source][target] = std::make_unique<SwapStar>(r);
+        if (_best_gains[source][target] < r.gain()) {
+          _best_gains[source][target] = r.gain();
+          set_best_op(source, target, r, stats);
         }
       }
+
+      stats[OperatorName::SwapStar].add_run(s_t_pairs.size(), start);
     }
+  }
+
+  if (!_input.has_homogeneous_locations() ||
+      !_input.has_homogeneous_profiles() || !_input.has_homogeneous_costs()) {
+    // RouteSplit stuff
+    if (!_skipped_operators[OperatorName::RouteSplit]) {
+      const auto start = utils::now();
 
-    if (!_input.has_homogeneous_locations() ||
-        !_input.has_homogeneous_profiles() || !_input.has_homogeneous_costs()) {
-      // RouteSplit stuff
       std::vector<Index> empty_route_ranks;
       empty_route_ranks.reserve(_input.vehicles.size());
 
@@ -1757,13 +2031,13 @@ void LocalSearch<Route,
 
       if (empty_route_ranks.size() >= 2) {
         for (const auto& [source, target] : s_t_pairs) {
-          if (target != source || best_priorities[source] > 0 ||
+          if (target != source || _best_priorities[source] > 0 ||
               _sol[source].size() < 2) {
             continue;
           }
 
           // RouteSplit stores a const& to empty_route_ranks, which
-          // will be invalid in the unique_ptr created below after
+          // will be invalid in the move stored below after
           // empty_route_ranks goes out of scope. This is fine because
           // that ref is only stored to compute gain right below, not
           // to apply the operator later on.
@@ -1773,166 +2047,996 @@ void LocalSearch<Route,
                        source,
                        empty_route_ranks,
                        _sol,
-                       best_gains[source][target]);
+                       _best_gains[source][target]);
 
-          if (best_gains[source][target] < r.gain()) {
-            best_gains[source][target] = r.gain();
-            best_ops[source][target] = std::make_unique<RouteSplit>(r);
+          if (_best_gains[source][target] < r.gain()) {
+            _best_gains[source][target] = r.gain();
+            set_best_op(source, target, r, stats);
           }
         }
       }
-    }
-
-    // Find best overall move, first checking priority increase then
-    // best gain if no priority increase is available.
-    best_priority = 0;
-    best_removal = std::numeric_limits<unsigned>::max();
-    best_gain = Eval();
-    Index best_source = 0;
-    Index best_target = 0;
-
-    for (unsigned s_v = 0; s_v < _nb_vehicles; ++s_v) {
-      if (std::tie(best_priority, best_removals[s_v], best_gain) <
-          std::tie(best_priorities[s_v], best_removal, best_gains[s_v][s_v])) {
-        best_priority = best_priorities[s_v];
-        best_removal = best_removals[s_v];
-        best_gain = best_gains[s_v][s_v];
-        best_source = s_v;
-        best_target = s_v;
-      }
-    }
 
-    if (best_priority == 0) {
-      for (unsigned s_v = 0; s_v < _nb_vehicles; ++s_v) {
-        for (unsigned t_v = 0; t_v < _nb_vehicles; ++t_v) {
-          if (best_gain < best_gains[s_v][t_v]) {
-            best_gain = best_gains[s_v][t_v];
-            best_source = s_v;
-            best_target = t_v;
-          }
-        }
-      }
+      stats[OperatorName::RouteSplit].add_run(s_t_pairs.size(), start);
     }
+  }
+}
 
-    // Apply matching operator.
-    if (best_priority > 0 || best_gain.cost > 0) {
-      assert(best_ops[best_source][best_target] != nullptr);
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::evaluate_all_moves(const RoutePairs& s_t_pairs) {
+  if (_nb_threads == 1 ||
+      s_t_pairs.size() < MIN_PAIRS_PER_THREAD * _nb_threads) {
+    OperatorsStats stats;
+    evaluate_priority_moves(s_t_pairs, stats);
+    evaluate_moves(s_t_pairs, stats);
+    add_stats(stats);
+    return;
+  }
 
-      best_ops[best_source][best_target]->apply();
+  // Spread pairs over threads in a round-robin fashion, each thread
+  // only writing entries for its own pairs. Priority moves are
+  // evaluated first as other operators skip routes with a priority
+  // increase.
+  for (auto& pairs : _thread_pairs) {
+    pairs.clear();
+  }
+  std::ranges::fill(_thread_stats, OperatorsStats());
+  for (std::size_t i = 0; i < s_t_pairs.size(); ++i) {
+    _thread_pairs[i % _nb_threads].push_back(s_t_pairs[i]);
+  }
 
-      auto update_candidates =
-        best_ops[best_source][best_target]->update_candidates();
+  _threads_barrier.arrive_and_wait();
+  evaluate_thread_moves(0);
+  _threads_barrier.arrive_and_wait();
 
-#ifndef NDEBUG
-      // Update route costs.
-      const auto previous_eval =
-        std::accumulate(update_candidates.begin(),
-                        update_candidates.end(),
-                        Eval(),
-                        [&](auto sum, auto c) {
-                          return sum + _sol_state.route_evals[c];
-                        });
-#endif
+  std::exception_ptr error = nullptr;
+  for (auto& thread_error : _thread_errors) {
+    if (error == nullptr) {
+      error = thread_error;
+    }
+    thread_error = nullptr;
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
 
-      for (auto v_rank : update_candidates) {
-        _sol_state.update_route_eval(_sol[v_rank]);
-        _sol_state.update_route_bbox(_sol[v_rank]);
-        _sol_state.update_costs(_sol[v_rank]);
-        _sol_state.update_skills(_sol[v_rank]);
-        _sol_state.update_priorities(_sol[v_rank]);
-        _sol_state.set_insertion_ranks(_sol[v_rank]);
-        _sol_state.set_node_gains(_sol[v_rank]);
-        _sol_state.set_edge_gains(_sol[v_rank]);
-        _sol_state.set_pd_matching_ranks(_sol[v_rank]);
-        _sol_state.set_pd_gains(_sol[v_rank]);
+  for (const auto& stats : _thread_stats) {
+    add_stats(stats);
+  }
+}
 
-        assert(_sol[v_rank].size() <= _input.vehicles[v_rank].max_tasks);
-        assert(_input.vehicles[v_rank].ok_for_range_bounds(
-          _sol_state.route_evals[v_rank]));
-      }
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::evaluate_thread_moves(std::size_t t) {
+  // Errors are stored so that all threads still go through the
+  // barrier.
+  try {
+    evaluate_priority_moves(_thread_pairs[t], _thread_stats[t]);
+  } catch (...) {
+    _thread_errors[t] = std::current_exception();
+  }
+
+  _threads_barrier.arrive_and_wait();
+
+  if (_thread_errors[t] == nullptr) {
+    try {
+      evaluate_moves(_thread_pairs[t], _thread_stats[t]);
+    } catch (...) {
+      _thread_errors[t] = std::current_exception();
+    }
+  }
+}
+
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::run_worker(std::size_t t) {
+  while (true) {
+    _threads_barrier.arrive_and_wait();
+    if (_stop_workers) {
+      return;
+    }
+    evaluate_thread_moves(t);
+    _threads_barrier.arrive_and_wait();
+  }
+}
+
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::add_stats(const OperatorsStats& stats) {
+  for (std::size_t i = 0; i < stats.size(); ++i) {
+    _operators_stats[i] += stats[i];
+    _recent_stats[i] += stats[i];
+  }
+}
+
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::update_skipped_operators() {
+  if (ADAPTIVE_PERIOD <= _nb_recent_moves) {
+    enable_all_operators();
+    return;
+  }
+
+  if (_nb_recent_moves < ADAPTIVE_WINDOW) {
+    return;
+  }
+
+  for (std::size_t i = 0; i < _recent_stats.size(); ++i) {
+    _skipped_operators[i] = (_recent_stats[i].applied_moves == 0);
+  }
+}
+
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::enable_all_operators() {
+  _skipped_operators.fill(false);
+  _recent_stats = OperatorsStats();
+  _nb_recent_moves = 0;
+}
+
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::run_ls_step() {
+  // Clear best moves from previous step, keeping slots.
+  for (Index s_v = 0; s_v < _nb_vehicles; ++s_v) {
+    for (Index t_v = 0; t_v < _nb_vehicles; ++t_v) {
+      reset_best_op(s_v, t_v);
+    }
+  }
+
+  // List of source/target pairs we need to test (all related vehicles
+  // at first, unless restricted to some routes).
+  RoutePairs s_t_pairs;
+  s_t_pairs.reserve(_nb_vehicles * _nb_vehicles);
+
+  auto set_all_pairs = [&](bool first_step) {
+    s_t_pairs.clear();
+    for (unsigned s_v = 0; s_v < _nb_vehicles; ++s_v) {
+      for (unsigned t_v = 0; t_v < _nb_vehicles; ++t_v) {
+        if (_input.vehicle_ok_with_vehicle(s_v, t_v) &&
+            (!first_step || !_first_step_routes.has_value() ||
+             _first_step_routes.value().contains(s_v) ||
+             _first_step_routes.value().contains(t_v))) {
+          s_t_pairs.emplace_back(s_v, t_v);
+        }
+      }
+    }
+  };
+
+  set_all_pairs(true);
+  _first_step_routes.reset();
+
+  // Store best gain for matching move.
+  _best_gains = std::vector<std::vector<Eval>>(_nb_vehicles,
+                                               std::vector<Eval>(_nb_vehicles,
+                                                                 Eval()));
+
+  // Store best priority increase and number of assigned tasks for use
+  // with operators involving a single route and unassigned jobs
+  // (UnassignedExchange and PriorityReplace).
+  _best_priorities = std::vector<Priority>(_nb_vehicles, 0);
+  _best_removals =
+    std::vector<unsigned>(_nb_vehicles, std::numeric_limits<unsigned>::max());
+
+  // Dummy init to enter first loop.
+  Eval best_gain(static_cast<Cost>(1));
+  Priority best_priority = 0;
+  auto best_removal = std::numeric_limits<unsigned>::max();
+
+  while (best_gain.cost > 0 || best_priority > 0) {
+    if (out_of_budget()) {
+      break;
+    }
+
+    if (_input.adaptive_operators()) {
+      update_skipped_operators();
+    }
+
+    evaluate_all_moves(s_t_pairs);
+
+    // Find best overall move, first checking priority increase then
+    // best gain if no priority increase is available.
+    best_priority = 0;
+    best_removal = std::numeric_limits<unsigned>::max();
+    best_gain = Eval();
+    Index best_source = 0;
+    Index best_target = 0;
+
+    for (unsigned s_v = 0; s_v < _nb_vehicles; ++s_v) {
+      if (std::tie(best_priority, _best_removals[s_v], best_gain) <
+          std::tie(_best_priorities[s_v],
+                   best_removal,
+                   _best_gains[s_v][s_v])) {
+        best_priority = _best_priorities[s_v];
+        best_removal = _best_removals[s_v];
+        best_gain = _best_gains[s_v][s_v];
+        best_source = s_v;
+        best_target = s_v;
+      }
+    }
+
+    if (best_priority == 0) {
+      for (unsigned s_v = 0; s_v < _nb_vehicles; ++s_v) {
+        for (unsigned t_v = 0; t_v < _nb_vehicles; ++t_v) {
+          if (best_gain < _best_gains[s_v][t_v]) {
+            best_gain = _best_gains[s_v][t_v];
+            best_source = s_v;
+            best_target = t_v;
+          }
+        }
+      }
+    }
+
+    // Apply matching operator.
+    if (best_priority > 0 || best_gain.cost > 0) {
+      std::vector<Index> update_candidates;
+      visit_best_op(best_source, best_target, [&](auto& op) {
+        op.apply();
+        update_candidates = op.update_candidates();
+
+        ++_operators_stats[op.get_name()].applied_moves;
+        ++_recent_stats[op.get_name()].applied_moves;
+      });
+      ++_nb_moves;
+      ++_nb_recent_moves;
+
+#ifndef NDEBUG
+      // Update route costs.
+      const auto previous_eval =
+        std::accumulate(update_candidates.begin(),
+                        update_candidates.end(),
+                        Eval(),
+                        [&](auto sum, auto c) {
+                          return sum + _sol_state.route_evals[c];
+                        });
+#endif
+
+      for (auto v_rank : update_candidates) {
+        _sol_state.update_route_eval(_sol[v_rank]);
+        _sol_state.update_route_bbox(_sol[v_rank]);
+        _sol_state.update_costs(_sol[v_rank]);
+        _sol_state.update_skills(_sol[v_rank]);
+        _sol_state.update_priorities(_sol[v_rank]);
+        _sol_state.set_insertion_ranks(_sol[v_rank]);
+        _sol_state.set_node_gains(_sol[v_rank]);
+        _sol_state.set_edge_gains(_sol[v_rank]);
+        _sol_state.set_pd_matching_ranks(_sol[v_rank]);
+        _sol_state.set_pd_gains(_sol[v_rank]);
+
+        assert(_sol[v_rank].size() <= _input.vehicles[v_rank].max_tasks);
+        assert(_input.vehicles[v_rank].ok_for_range_bounds(
+          _sol_state.route_evals[v_rank]));
+      }
+
+#ifndef NDEBUG
+      const auto new_eval =
+        std::accumulate(update_candidates.begin(),
+                        update_candidates.end(),
+                        Eval(),
+                        [&](auto sum, auto c) {
+                          return sum + _sol_state.route_evals[c];
+                        });
+      assert(new_eval + best_gain == previous_eval);
+#endif
+
+      std::vector<Index> addition_candidates;
+      visit_best_op(best_source, best_target, [&](const auto& op) {
+        addition_candidates = op.addition_candidates();
+      });
+
+      auto modified_vehicles = try_job_additions(addition_candidates, 0);
+
+      // Extend update_candidates in case a vehicle was not modified
+      // by the operator itself but afterward by
+      // try_job_additions. Can happen e.g. with UnassignedExchange.
+      for (const auto v : update_candidates) {
+        modified_vehicles.erase(v);
+      }
+      for (const auto v : modified_vehicles) {
+        update_candidates.push_back(v);
+      }
+
+      _modified_routes.insert(update_candidates.begin(),
+                              update_candidates.end());
+
+      // Set gains to zero for what needs to be recomputed in the next
+      // round and set route pairs accordingly.
+      s_t_pairs.clear();
+      for (auto v_rank : update_candidates) {
+        _best_gains[v_rank].assign(_nb_vehicles, Eval());
+        _best_priorities[v_rank] = 0;
+        _best_removals[v_rank] = std::numeric_limits<unsigned>::max();
+        for (Index v = 0; v < _nb_vehicles; ++v) {
+          reset_best_op(v_rank, v);
+        }
+      }
+
+      for (unsigned v = 0; v < _nb_vehicles; ++v) {
+        for (auto v_rank : update_candidates) {
+          if (_input.vehicle_ok_with_vehicle(v, v_rank)) {
+            _best_gains[v][v_rank] = Eval();
+            reset_best_op(v, v_rank);
+
+            s_t_pairs.emplace_back(v, v_rank);
+            if (v != v_rank) {
+              s_t_pairs.emplace_back(v_rank, v);
+            }
+          }
+        }
+      }
+
+      // Pairs of updated routes are listed twice, which would make
+      // threads race on the same entries.
+      std::ranges::sort(s_t_pairs);
+      const auto [first, last] = std::ranges::unique(s_t_pairs);
+      s_t_pairs.erase(first, last);
+
+      for (unsigned v = 0; v < _nb_vehicles; ++v) {
+        if (!has_best_op(v, v)) {
+          continue;
+        }
+
+        bool invalidate_move = false;
+
+        visit_best_op(v, v, [&](const auto& op) {
+          for (auto req_u : op.required_unassigned()) {
+            if (!_sol_state.unassigned.contains(req_u)) {
+              // This move should be invalidated because a required
+              // unassigned job has been added by try_job_additions in
+              // the meantime.
+              invalidate_move = true;
+              break;
+            }
+          }
+
+          for (auto v_rank : update_candidates) {
+            invalidate_move = invalidate_move || op.invalidated_by(v_rank);
+          }
+        });
+
+        if (invalidate_move) {
+          _best_gains[v][v] = Eval();
+          _best_priorities[v] = 0;
+          _best_removals[v] = std::numeric_limits<unsigned>::max();
+          reset_best_op(v, v);
+          s_t_pairs.emplace_back(v, v);
+        }
+      }
+    } else if (std::ranges::any_of(_skipped_operators,
+                                   [](bool skipped) { return skipped; })) {
+      // No improving move left for enabled operators, so check all
+      // pairs with all operators before concluding.
+      enable_all_operators();
+      set_all_pairs(false);
+      best_gain = Eval(static_cast<Cost>(1));
+    }
+  }
+}
+
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::run() {
+  // Ruin and recreate iterations require a budget to stop.
+  const bool ruin_and_recreate =
+    _input.ruin_and_recreate() &&
+    (_deadline.has_value() || _max_moves.has_value());
+
+  bool try_ls_step = true;
+
+  while (try_ls_step) {
+    // A round of local search.
+    run_ls_step();
+
+    // Comparison with indicators for current solution.
+    if (const utils::SolutionIndicators current_sol_indicators(_input, _sol);
+        current_sol_indicators < _best_sol_indicators) {
+      _best_sol_indicators = current_sol_indicators;
+      _best_sol = _sol;
+    } else {
+      // No improvement so back to previous best known for further
+      // steps.
+      if (_best_sol_indicators < current_sol_indicators) {
+        _sol = _best_sol;
+        _sol_state.setup(_sol);
+      }
+
+      if (_completed_depth.has_value()) {
+        // Rule out situation with first descent not yielding a better
+        // solution.
+        ++_completed_depth.value();
+      }
+    }
+
+    if (!_completed_depth.has_value()) {
+      // End of first descent.
+      _completed_depth = 0;
+
+      if (ruin_and_recreate) {
+        run_ruin_and_recreate();
+        return;
+      }
+    }
+
+    // Try again on each improvement until we reach last job removal
+    // level or budget is exhausted.
+    assert(_completed_depth.has_value());
+    auto nb_removal = _completed_depth.value() + 1;
+    try_ls_step = (nb_removal <= _depth) && !out_of_budget();
+
+    if (try_ls_step) {
+      // Get a looser situation by removing jobs.
+      for (unsigned i = 0; i < nb_removal; ++i) {
+        remove_from_routes();
+        for (std::size_t v = 0; v < _sol.size(); ++v) {
+          // Update what is required for consistency in
+          // remove_from_route.
+          _sol_state.update_costs(_sol[v]);
+          _sol_state.update_route_eval(_sol[v]);
+          _sol_state.update_route_bbox(_sol[v]);
+          _sol_state.set_node_gains(_sol[v]);
+          _sol_state.set_pd_matching_ranks(_sol[v]);
+          _sol_state.set_pd_gains(_sol[v]);
+        }
+      }
+
+      // Update stored data that has not been maintained while
+      // removing.
+      for (std::size_t v = 0; v < _sol.size(); ++v) {
+        _sol_state.update_skills(_sol[v]);
+        _sol_state.update_priorities(_sol[v]);
+        _sol_state.set_insertion_ranks(_sol[v]);
+        _sol_state.set_edge_gains(_sol[v]);
+      }
+
+      // Refill jobs.
+      constexpr double refill_regret = 1.5;
+      try_job_additions(_all_routes, refill_regret);
+    }
+  }
+}
 
-#ifndef NDEBUG
-      const auto new_eval =
-        std::accumulate(update_candidates.begin(),
-                        update_candidates.end(),
-                        Eval(),
-                        [&](auto sum, auto c) {
-                          return sum + _sol_state.route_evals[c];
-                        });
-      assert(new_eval + best_gain == previous_eval);
-#endif
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+void LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::reoptimize(std::unordered_set<Index> routes) {
+  if (!_sol_state.unassigned.empty()) {
+    const auto modified_routes = try_job_additions(_all_routes, 0);
+    routes.insert(modified_routes.begin(), modified_routes.end());
+  }
 
-      auto modified_vehicles =
-        try_job_additions(best_ops[best_source][best_target]
-                            ->addition_candidates(),
-                          0);
+  _first_step_routes = std::move(routes);
+  run();
+}
 
-      // Extend update_candidates in case a vehicle was not modified
-      // by the operator itself but afterward by
-      // try_job_additions. Can happen e.g. with UnassignedExchange.
-      for (const auto v : update_candidates) {
-        modified_vehicles.erase(v);
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+Eval LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::job_route_cost(Index v_target, Index v, Index r) {
+  assert(v != v_target);
+
+  Eval eval = NO_EVAL;
+  const auto job_index = _input.jobs[_sol[v].route[r]].index();
+
+  const auto& vehicle = _input.vehicles[v_target];
+  if (vehicle.has_start()) {
+    const auto start_index = vehicle.start.value().index();
+    const auto start_eval = vehicle.eval(start_index, job_index);
+    eval = std::min(eval, start_eval);
+  }
+  if (vehicle.has_end()) {
+    const auto end_index = vehicle.end.value().index();
+    const auto end_eval = vehicle.eval(job_index, end_index);
+    eval = std::min(eval, end_eval);
+  }
+  if (_sol[v_target].size() != 0) {
+    // Find jobs in target route with minimal cost from and to job.
+    auto min_from = std::numeric_limits<Cost>::max();
+    auto min_to = std::numeric_limits<Cost>::max();
+    auto cheapest_from_index = _input.jobs[_sol[v_target].route[0]].index();
+    auto cheapest_to_index = cheapest_from_index;
+
+    for (const auto j : _sol[v_target].route) {
+      const auto index = _input.jobs[j].index();
+      if (const auto cost_from = vehicle.cost(job_index, index);
+          cost_from < min_from) {
+        min_from = cost_from;
+        cheapest_from_index = index;
       }
-      for (const auto v : modified_vehicles) {
-        update_candidates.push_back(v);
+      if (const auto cost_to = vehicle.cost(index, job_index);
+          cost_to < min_to) {
+        min_to = cost_to;
+        cheapest_to_index = index;
       }
+    }
 
-      // Set gains to zero for what needs to be recomputed in the next
-      // round and set route pairs accordingly.
-      s_t_pairs.clear();
-      for (auto v_rank : update_candidates) {
-        best_gains[v_rank].assign(_nb_vehicles, Eval());
-        best_priorities[v_rank] = 0;
-        best_removals[v_rank] = std::numeric_limits<unsigned>::max();
-        best_ops[v_rank] = std::vector<std::unique_ptr<Operator>>(_nb_vehicles);
-      }
+    const auto eval_from = vehicle.eval(cheapest_from_index, job_index);
+    eval = std::min(eval, eval_from);
 
-      for (unsigned v = 0; v < _nb_vehicles; ++v) {
-        for (auto v_rank : update_candidates) {
-          if (_input.vehicle_ok_with_vehicle(v, v_rank)) {
-            best_gains[v][v_rank] = Eval();
-            best_ops[v][v_rank] = std::unique_ptr<Operator>();
+    const auto eval_to = vehicle.eval(job_index, cheapest_to_index);
+    eval = std::min(eval, eval_to);
+  }
 
-            s_t_pairs.emplace_back(v, v_rank);
-            if (v != v_rank) {
-              s_t_pairs.emplace_back(v_rank, v);
-            }
-          }
-        }
-      }
+  return eval;
+}
 
-      for (unsigned v = 0; v < _nb_vehicles; ++v) {
-        if (best_ops[v][v] == nullptr) {
-          continue;
-        }
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+Eval LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::relocate_cost_lower_bound(Index v, Index r) {
+  Eval best_bound = NO_EVAL;
 
-        bool invalidate_move = false;
+  for (std::size_t other_v = 0; other_v < _sol.size(); ++other_v) {
+    if (other_v == v ||
+        !_input.vehicle_ok_with_job(other_v, _sol[v].route[r])) {
+      continue;
+    }
 
-        for (auto req_u : best_ops[v][v]->required_unassigned()) {
-          if (!_sol_state.unassigned.contains(req_u)) {
-            // This move should be invalidated because a required
-            // unassigned job has been added by try_job_additions in
-            // the meantime.
-            invalidate_move = true;
-            break;
-          }
-        }
+    best_bound = std::min(best_bound, job_route_cost(other_v, v, r));
+  }
 
-        for (auto v_rank : update_candidates) {
-          invalidate_move =
-            invalidate_move || best_ops[v][v]->invalidated_by(v_rank);
-        }
+  return best_bound;
+}
 
-        if (invalidate_move) {
-          best_gains[v][v] = Eval();
-          best_priorities[v] = 0;
-          best_removals[v] = std::numeric_limits<unsigned>::max();
-          best_ops[v][v] = std::unique_ptr<Operator>();
-          s_t_pairs.emplace_back(v, v);
-        }
-      }
+template <class Route,
+          class UnassignedExchange,
+          class CrossExchange,
+          class MixedExchange,
+          class TwoOpt,
+          class ReverseTwoOpt,
+          class Relocate,
+          class OrOpt,
+          class IntraExchange,
+          class IntraCrossExchange,
+          class IntraMixedExchange,
+          class IntraRelocate,
+          class IntraOrOpt,
+          class IntraTwoOpt,
+          class PDShift,
+          class RouteExchange,
+          class SwapStar,
+          class RouteSplit,
+          class PriorityReplace,
+          class TSPFix>
+Eval LocalSearch<Route,
+                 UnassignedExchange,
+                 CrossExchange,
+                 MixedExchange,
+                 TwoOpt,
+                 ReverseTwoOpt,
+                 Relocate,
+                 OrOpt,
+                 IntraExchange,
+                 IntraCrossExchange,
+                 IntraMixedExchange,
+                 IntraRelocate,
+                 IntraOrOpt,
+                 IntraTwoOpt,
+                 PDShift,
+                 RouteExchange,
+                 SwapStar,
+                 RouteSplit,
+                 PriorityReplace,
+                 TSPFix>::relocate_cost_lower_bound(Index v,
+                                                    Index r1,
+                                                    Index r2) {
+  Eval best_bound = NO_EVAL;
+
+  for (std::size_t other_v = 0; other_v < _sol.size(); ++other_v) {
+    if (other_v == v ||
+        !_input.vehicle_ok_with_job(other_v, _sol[v].route[r1])) {
+      continue;
     }
+
+    best_bound =
+      std::min(best_bound,
+               job_route_cost(other_v, v, r1) + job_route_cost(other_v, v, r2));
   }
+
+  return best_bound;
 }
 
 template <class Route,
@@ -1974,75 +3078,72 @@ void LocalSearch<Route,
                  SwapStar,
                  RouteSplit,
                  PriorityReplace,
-                 TSPFix>::run() {
-  bool try_ls_step = true;
+                 TSPFix>::remove_from_routes() {
+  // Remove best node candidate from all routes.
+  std::vector<std::pair<Index, Index>> routes_and_ranks;
+  routes_and_ranks.reserve(_sol.size());
 
-  while (try_ls_step) {
-    // A round of local search.
-    run_ls_step();
+  // Removal gains and ranks for jobs in current route.
+  std::vector<std::pair<Eval, Index>> candidates;
 
-    // Comparison with indicators for current solution.
-    if (const utils::SolutionIndicators current_sol_indicators(_input, _sol);
-        current_sol_indicators < _best_sol_indicators) {
-      _best_sol_indicators = current_sol_indicators;
-      _best_sol = _sol;
-    } else {
-      // No improvement so back to previous best known for further
-      // steps.
-      if (_best_sol_indicators < current_sol_indicators) {
-        _sol = _best_sol;
-        _sol_state.setup(_sol);
-      }
+  for (std::size_t v = 0; v < _sol.size(); ++v) {
+    if (_sol[v].empty()) {
+      continue;
+    }
 
-      if (_completed_depth.has_value()) {
-        // Rule out situation with first descent not yielding a better
-        // solution.
-        ++_completed_depth.value();
+    candidates.clear();
+    for (std::size_t r = 0; r < _sol[v].size(); ++r) {
+      const auto& current_job = _input.jobs[_sol[v].route[r]];
+      if (current_job.type == JOB_TYPE::SINGLE) {
+        candidates.emplace_back(_sol_state.node_gains[v][r], r);
+      } else if (current_job.type == JOB_TYPE::PICKUP) {
+        candidates.emplace_back(_sol_state.pd_gains[v][r], r);
       }
     }
+    std::ranges::sort(candidates, [](const auto& lhs, const auto& rhs) {
+      return rhs.first < lhs.first;
+    });
 
-    if (!_completed_depth.has_value()) {
-      // End of first descent.
-      _completed_depth = 0;
-    }
+    // Try removing the best node (good gain on current route and
+    // small cost to closest node in another compatible route).
+    Index best_rank = 0;
+    Eval best_gain = NO_GAIN;
 
-    // Try again on each improvement until we reach last job removal
-    // level or deadline is met.
-    assert(_completed_depth.has_value());
-    auto nb_removal = _completed_depth.value() + 1;
-    try_ls_step = (nb_removal <= _depth) &&
-                  (!_deadline.has_value() || utils::now() < _deadline.value());
+    for (const auto& [removal_gain, r] : candidates) {
+      if (removal_gain < best_gain) {
+        // Relocate cost lower bound is non-negative so no remaining
+        // candidate can beat best gain.
+        break;
+      }
 
-    if (try_ls_step) {
-      // Get a looser situation by removing jobs.
-      for (unsigned i = 0; i < nb_removal; ++i) {
-        remove_from_routes();
-        for (std::size_t v = 0; v < _sol.size(); ++v) {
-          // Update what is required for consistency in
-          // remove_from_route.
-          _sol_state.update_costs(_sol[v]);
-          _sol_state.update_route_eval(_sol[v]);
-          _sol_state.update_route_bbox(_sol[v]);
-          _sol_state.set_node_gains(_sol[v]);
-          _sol_state.set_pd_matching_ranks(_sol[v]);
-          _sol_state.set_pd_gains(_sol[v]);
-        }
+      Eval current_gain;
+
+      if (_input.jobs[_sol[v].route[r]].type == JOB_TYPE::SINGLE) {
+        current_gain = removal_gain - relocate_cost_lower_bound(v, r);
+      } else {
+        const auto delivery_r = _sol_state.matching_delivery_rank[v][r];
+        current_gain =
+          removal_gain - relocate_cost_lower_bound(v, r, delivery_r);
       }
 
-      // Update stored data that has not been maintained while
-      // removing.
-      for (std::size_t v = 0; v < _sol.size(); ++v) {
-        _sol_state.update_skills(_sol[v]);
-        _sol_state.update_priorities(_sol[v]);
-        _sol_state.set_insertion_ranks(_sol[v]);
-        _sol_state.set_edge_gains(_sol[v]);
+      // Lowest rank wins on equal gains. Only check validity if
+      // required.
+      if ((best_gain < current_gain ||
+           (current_gain == best_gain && r < best_rank)) &&
+          is_valid_job_removal(v, r)) {
+        best_gain = current_gain;
+        best_rank = r;
       }
+    }
 
-      // Refill jobs.
-      constexpr double refill_regret = 1.5;
-      try_job_additions(_all_routes, refill_regret);
+    if (best_gain != NO_GAIN) {
+      routes_and_ranks.emplace_back(v, best_rank);
     }
   }
+
+  for (const auto& [v, r] : routes_and_ranks) {
+    remove_job(v, r);
+  }
 }
 
 template <class Route,
@@ -2065,7 +3166,7 @@ template <class Route,
           class RouteSplit,
           class PriorityReplace,
           class TSPFix>
-Eval LocalSearch<Route,
+bool LocalSearch<Route,
                  UnassignedExchange,
                  CrossExchange,
                  MixedExchange,
@@ -2084,40 +3185,38 @@ Eval LocalSearch<Route,
                  SwapStar,
                  RouteSplit,
                  PriorityReplace,
-                 TSPFix>::job_route_cost(Index v_target, Index v, Index r) {
-  assert(v != v_target);
-
-  Eval eval = NO_EVAL;
-  const auto job_index = _input.jobs[_sol[v].route[r]].index();
+                 TSPFix>::is_valid_job_removal(Index v,
+                                               Index r) const {
+  const auto& current_job = _input.jobs[_sol[v].route[r]];
+  const auto& route_eval = _sol_state.route_evals[v];
 
-  const auto& vehicle = _input.vehicles[v_target];
-  if (vehicle.has_start()) {
-    const auto start_index = vehicle.start.value().index();
-    const auto start_eval = vehicle.eval(start_index, job_index);
-    eval = std::min(eval, start_eval);
+  if (current_job.type == JOB_TYPE::SINGLE) {
+    return _input.vehicles[v].ok_for_range_bounds(
+             route_eval - _sol_state.node_gains[v][r]) &&
+           _sol[v].is_valid_removal(_input, r, 1);
   }
-  if (vehicle.has_end()) {
-    const auto end_index = vehicle.end.value().index();
-    const auto end_eval = vehicle.eval(job_index, end_index);
-    eval = std::min(eval, end_eval);
+
+  assert(current_job.type == JOB_TYPE::PICKUP);
+  if (!_input.vehicles[v].ok_for_range_bounds(route_eval -
+                                              _sol_state.pd_gains[v][r])) {
+    return false;
   }
-  if (_sol[v_target].size() != 0) {
-    const auto cheapest_from_rank =
-      _sol_state.cheapest_job_rank_in_routes_from[v][v_target][r];
-    const auto cheapest_from_index =
-      _input.jobs[_sol[v_target].route[cheapest_from_rank]].index();
-    const auto eval_from = vehicle.eval(cheapest_from_index, job_index);
-    eval = std::min(eval, eval_from);
 
-    const auto cheapest_to_rank =
-      _sol_state.cheapest_job_rank_in_routes_to[v][v_target][r];
-    const auto cheapest_to_index =
-      _input.jobs[_sol[v_target].route[cheapest_to_rank]].index();
-    const auto eval_to = vehicle.eval(job_index, cheapest_to_index);
-    eval = std::min(eval, eval_to);
+  const auto delivery_r = _sol_state.matching_delivery_rank[v][r];
+  if (delivery_r == r + 1) {
+    return _sol[v].is_valid_removal(_input, r, 2);
   }
 
-  return eval;
+  std::vector<Index> between_pd(_sol[v].route.begin() + r + 1,
+                                _sol[v].route.begin() + delivery_r);
+
+  return _sol[v].is_valid_addition_for_tw(_input,
+                                          _sol[v].delivery_in_range(r + 1,
+                                                                    delivery_r),
+                                          between_pd.begin(),
+                                          between_pd.end(),
+                                          r,
+                                          delivery_r + 1);
 }
 
 template <class Route,
@@ -2140,7 +3239,7 @@ template <class Route,
           class RouteSplit,
           class PriorityReplace,
           class TSPFix>
-Eval LocalSearch<Route,
+void LocalSearch<Route,
                  UnassignedExchange,
                  CrossExchange,
                  MixedExchange,
@@ -2159,19 +3258,33 @@ Eval LocalSearch<Route,
                  SwapStar,
                  RouteSplit,
                  PriorityReplace,
-                 TSPFix>::relocate_cost_lower_bound(Index v, Index r) {
-  Eval best_bound = NO_EVAL;
-
-  for (std::size_t other_v = 0; other_v < _sol.size(); ++other_v) {
-    if (other_v == v ||
-        !_input.vehicle_ok_with_job(other_v, _sol[v].route[r])) {
-      continue;
-    }
+                 TSPFix>::remove_job(Index v,
+                                     Index r) {
+  _sol_state.unassigned.insert(_sol[v].route[r]);
 
-    best_bound = std::min(best_bound, job_route_cost(other_v, v, r));
+  const auto& current_job = _input.jobs[_sol[v].route[r]];
+  if (current_job.type == JOB_TYPE::SINGLE) {
+    _sol[v].remove(_input, r, 1);
+    return;
   }
 
-  return best_bound;
+  assert(current_job.type == JOB_TYPE::PICKUP);
+  const auto delivery_r = _sol_state.matching_delivery_rank[v][r];
+  _sol_state.unassigned.insert(_sol[v].route[delivery_r]);
+
+  if (delivery_r == r + 1) {
+    _sol[v].remove(_input, r, 2);
+  } else {
+    std::vector<Index> between_pd(_sol[v].route.begin() + r + 1,
+                                  _sol[v].route.begin() + delivery_r);
+
+    _sol[v].replace(_input,
+                    _sol[v].delivery_in_range(r + 1, delivery_r),
+                    between_pd.begin(),
+                    between_pd.end(),
+                    r,
+                    delivery_r + 1);
+  }
 }
 
 template <class Route,
@@ -2194,42 +3307,146 @@ template <class Route,
           class RouteSplit,
           class PriorityReplace,
           class TSPFix>
-Eval LocalSearch<Route,
-                 UnassignedExchange,
-                 CrossExchange,
-                 MixedExchange,
-                 TwoOpt,
-                 ReverseTwoOpt,
-                 Relocate,
-                 OrOpt,
-                 IntraExchange,
-                 IntraCrossExchange,
-                 IntraMixedExchange,
-                 IntraRelocate,
-                 IntraOrOpt,
-                 IntraTwoOpt,
-                 PDShift,
-                 RouteExchange,
-                 SwapStar,
-                 RouteSplit,
-                 PriorityReplace,
-                 TSPFix>::relocate_cost_lower_bound(Index v,
-                                                    Index r1,
-                                                    Index r2) {
-  Eval best_bound = NO_EVAL;
+std::unordered_set<Index> LocalSearch<Route,
+                                      UnassignedExchange,
+                                      CrossExchange,
+                                      MixedExchange,
+                                      TwoOpt,
+                                      ReverseTwoOpt,
+                                      Relocate,
+                                      OrOpt,
+                                      IntraExchange,
+                                      IntraCrossExchange,
+                                      IntraMixedExchange,
+                                      IntraRelocate,
+                                      IntraOrOpt,
+                                      IntraTwoOpt,
+                                      PDShift,
+                                      RouteExchange,
+                                      SwapStar,
+                                      RouteSplit,
+                                      PriorityReplace,
+                                      TSPFix>::ruin(Ruin op,
+                                                    unsigned nb_removals) {
+  // Removal candidates are assigned single jobs and pickups, a
+  // delivery being removed along with its pickup.
+  std::vector<std::pair<Index, Index>> positions(_input.jobs.size());
+  std::vector<Index> candidates;
+  for (std::size_t v = 0; v < _sol.size(); ++v) {
+    for (std::size_t r = 0; r < _sol[v].size(); ++r) {
+      const auto j = _sol[v].route[r];
+      positions[j] = {v, r};
+      if (_input.jobs[j].type != JOB_TYPE::DELIVERY) {
+        candidates.push_back(j);
+      }
+    }
+  }
 
-  for (std::size_t other_v = 0; other_v < _sol.size(); ++other_v) {
-    if (other_v == v ||
-        !_input.vehicle_ok_with_job(other_v, _sol[v].route[r1])) {
+  if (candidates.empty()) {
+    return {};
+  }
+
+  // Order candidates for removal.
+  switch (op) {
+  case Ruin::RANDOM:
+    std::ranges::shuffle(candidates, _rng);
+    break;
+  case Ruin::WORST: {
+    // Higher (noisy) removal gains first.
+    std::uniform_real_distribution<double> noise(1 - WORST_RUIN_NOISE,
+                                                 1 + WORST_RUIN_NOISE);
+    std::vector<std::pair<double, Index>> gains;
+    gains.reserve(candidates.size());
+    for (const auto j : candidates) {
+      const auto [v, r] = positions[j];
+      const auto& gain = (_input.jobs[j].type == JOB_TYPE::SINGLE)
+                           ? _sol_state.node_gains[v][r]
+                           : _sol_state.pd_gains[v][r];
+      gains.emplace_back(static_cast<double>(gain.cost) * noise(_rng), j);
+    }
+    std::ranges::sort(gains, std::greater<>());
+    std::ranges::transform(gains, candidates.begin(), [](const auto& g) {
+      return g.second;
+    });
+    break;
+  }
+  case Ruin::RELATED: {
+    // Closest jobs to a random seed job first, including itself.
+    const auto seed =
+      candidates[std::uniform_int_distribution<std::size_t>(
+        0,
+        candidates.size() - 1)(_rng)];
+    const auto& vehicle = _input.vehicles[positions[seed].first];
+    const auto seed_index = _input.jobs[seed].index();
+
+    std::vector<std::pair<Cost, Index>> costs;
+    costs.reserve(candidates.size());
+    for (const auto j : candidates) {
+      const auto index = _input.jobs[j].index();
+      costs.emplace_back(std::min(vehicle.cost(seed_index, index),
+                                  vehicle.cost(index, seed_index)),
+                         j);
+    }
+    std::ranges::sort(costs);
+    std::ranges::transform(costs, candidates.begin(), [](const auto& c) {
+      return c.second;
+    });
+    break;
+  }
+  case Ruin::ROUTE: {
+    // Empty the route of a random candidate.
+    const auto v =
+      positions[candidates[std::uniform_int_distribution<std::size_t>(
+                  0,
+                  candidates.size() - 1)(_rng)]]
+        .first;
+    std::erase_if(candidates,
+                  [&](const auto j) { return positions[j].first != v; });
+    nb_removals = candidates.size();
+    break;
+  }
+  }
+
+  std::unordered_set<Index> modified_routes;
+  unsigned nb_removed = 0;
+
+  for (const auto j : candidates) {
+    if (nb_removed == nb_removals) {
+      break;
+    }
+
+    const auto v = positions[j].first;
+    if (!is_valid_job_removal(v, positions[j].second)) {
       continue;
     }
 
-    best_bound =
-      std::min(best_bound,
-               job_route_cost(other_v, v, r1) + job_route_cost(other_v, v, r2));
+    remove_job(v, positions[j].second);
+    ++nb_removed;
+    modified_routes.insert(v);
+
+    for (std::size_t r = 0; r < _sol[v].size(); ++r) {
+      positions[_sol[v].route[r]].second = r;
+    }
+
+    // Update what is required for validity checks on further
+    // removals.
+    _sol_state.update_costs(_sol[v]);
+    _sol_state.update_route_eval(_sol[v]);
+    _sol_state.update_route_bbox(_sol[v]);
+    _sol_state.set_node_gains(_sol[v]);
+    _sol_state.set_pd_matching_ranks(_sol[v]);
+    _sol_state.set_pd_gains(_sol[v]);
   }
 
-  return best_bound;
+  // Update stored data that has not been maintained while removing.
+  for (const auto v : modified_routes) {
+    _sol_state.update_skills(_sol[v]);
+    _sol_state.update_priorities(_sol[v]);
+    _sol_state.set_insertion_ranks(_sol[v]);
+    _sol_state.set_edge_gains(_sol[v]);
+  }
+
+  return modified_routes;
 }
 
 template <class Route,
@@ -2271,121 +3488,123 @@ void LocalSearch<Route,
                  SwapStar,
                  RouteSplit,
                  PriorityReplace,
-                 TSPFix>::remove_from_routes() {
-  // Store nearest job from and to any job in any route for constant
-  // time access down the line.
-  for (std::size_t v1 = 0; v1 < _nb_vehicles; ++v1) {
-    for (std::size_t v2 = 0; v2 < _nb_vehicles; ++v2) {
-      if (v2 == v1) {
-        continue;
-      }
-      _sol_state.update_cheapest_job_rank_in_routes(_sol[v1].route,
-                                                    _sol[v2].route,
-                                                    v1,
-                                                    v2);
+                 TSPFix>::run_ruin_and_recreate() {
+  // Solution ruin and recreate iterations start from. Only routes
+  // modified since _sol and current_sol last matched are copied upon
+  // acceptance or restored upon rejection.
+  auto current_sol = _sol;
+  auto current_unassigned = _sol_state.unassigned;
+  utils::SolutionIndicators current_indicators(_input, _sol);
+  _modified_routes.clear();
+
+  std::array<double, NB_RUINS> ruin_weights;
+  ruin_weights.fill(MIN_WEIGHT);
+  std::array<double, NB_RECREATES> recreate_weights;
+  recreate_weights.fill(MIN_WEIGHT);
+
+  const auto start = utils::now();
+  const auto start_moves = _nb_moves;
+
+  while (!out_of_budget()) {
+    // Share of remaining budget already spent.
+    double progress;
+    if (_max_moves.has_value()) {
+      progress = static_cast<double>(_nb_moves - start_moves) /
+                 static_cast<double>(_max_moves.value() - start_moves);
+    } else {
+      assert(_deadline.has_value());
+      const std::chrono::duration<double> elapsed = utils::now() - start;
+      const std::chrono::duration<double> total = _deadline.value() - start;
+      progress = (total.count() > 0) ? elapsed / total : 1;
     }
-  }
-
-  // Remove best node candidate from all routes.
-  std::vector<std::pair<Index, Index>> routes_and_ranks;
-  routes_and_ranks.reserve(_sol.size());
 
-  for (std::size_t v = 0; v < _sol.size(); ++v) {
-    if (_sol[v].empty()) {
-      continue;
+    const auto ruin_rank =
+      std::discrete_distribution<std::size_t>(ruin_weights.begin(),
+                                              ruin_weights.end())(_rng);
+    const auto recreate_rank =
+      std::discrete_distribution<std::size_t>(recreate_weights.begin(),
+                                              recreate_weights.end())(_rng);
+
+    const auto nb_assigned =
+      std::accumulate(_sol.begin(),
+                      _sol.end(),
+                      std::size_t(0),
+                      [](auto sum, const auto& r) { return sum + r.size(); });
+    const auto max_removals =
+      std::clamp(static_cast<unsigned>(MAX_RUIN_RATIO *
+                                       static_cast<double>(nb_assigned)),
+                 MIN_RUIN,
+                 MAX_RUIN);
+    const auto nb_removals =
+      std::uniform_int_distribution<unsigned>(MIN_RUIN, max_removals)(_rng);
+
+    auto modified_routes = ruin(static_cast<Ruin>(ruin_rank), nb_removals);
+
+    std::unordered_set<Index> added_routes;
+    switch (static_cast<Recreate>(recreate_rank)) {
+    case Recreate::REGRET:
+      added_routes = try_job_additions(_all_routes, RECREATE_REGRET);
+      break;
+    case Recreate::GREEDY:
+      added_routes = try_job_additions(_all_routes, 0);
+      break;
+    case Recreate::NOISY_GREEDY:
+      added_routes = try_job_additions(_all_routes, 0, RECREATE_NOISE);
+      break;
     }
+    modified_routes.insert(added_routes.begin(), added_routes.end());
+    _modified_routes.insert(modified_routes.begin(), modified_routes.end());
 
-    // Try removing the best node (good gain on current route and
-    // small cost to closest node in another compatible route).
-    Index best_rank = 0;
-    Eval best_gain = NO_GAIN;
-
-    const auto& route_eval = _sol_state.route_evals[v];
-
-    for (std::size_t r = 0; r < _sol[v].size(); ++r) {
-      const auto& current_job = _input.jobs[_sol[v].route[r]];
-      if (current_job.type == JOB_TYPE::DELIVERY) {
-        continue;
-      }
-
-      Eval current_gain;
-      bool valid_removal = false;
-
-      if (current_job.type == JOB_TYPE::SINGLE) {
-        const auto& removal_gain = _sol_state.node_gains[v][r];
-        current_gain = removal_gain - relocate_cost_lower_bound(v, r);
+    // Account for each iteration as a move so that a moves budget is
+    // exhausted even without any applied local search move.
+    ++_nb_moves;
 
-        if (best_gain < current_gain) {
-          // Only check validity if required.
-          valid_removal =
-            _input.vehicles[v].ok_for_range_bounds(route_eval - removal_gain) &&
-            _sol[v].is_valid_removal(_input, r, 1);
-        }
-      } else {
-        assert(current_job.type == JOB_TYPE::PICKUP);
-        const auto delivery_r = _sol_state.matching_delivery_rank[v][r];
-        const auto& removal_gain = _sol_state.pd_gains[v][r];
-        current_gain =
-          removal_gain - relocate_cost_lower_bound(v, r, delivery_r);
+    // Only routes modified by ruin and recreate can yield improving
+    // moves in first step as current solution is a local optimum.
+    _first_step_routes = std::move(modified_routes);
+    run_ls_step();
 
-        if (best_gain < current_gain &&
-            _input.vehicles[v].ok_for_range_bounds(route_eval - removal_gain)) {
-          // Only check validity if required.
-          if (delivery_r == r + 1) {
-            valid_removal = _sol[v].is_valid_removal(_input, r, 2);
-          } else {
-            std::vector<Index> between_pd(_sol[v].route.begin() + r + 1,
-                                          _sol[v].route.begin() + delivery_r);
+    const utils::SolutionIndicators sol_indicators(_input, _sol);
 
-            const auto delivery_between_pd =
-              _sol[v].delivery_in_range(r + 1, delivery_r);
+    double score = 0;
+    if (sol_indicators < _best_sol_indicators) {
+      _best_sol_indicators = sol_indicators;
+      _best_sol = _sol;
+      score = NEW_BEST_SCORE;
+    } else if (sol_indicators < current_indicators) {
+      score = IMPROVEMENT_SCORE;
+    } else if (current_indicators < sol_indicators &&
+               sol_indicators.priority_sum ==
+                 _best_sol_indicators.priority_sum &&
+               sol_indicators.assigned == _best_sol_indicators.assigned &&
+               static_cast<double>(sol_indicators.eval.cost) <=
+                 (1 + RECORD_DEVIATION * (1 - progress)) *
+                   static_cast<double>(_best_sol_indicators.eval.cost)) {
+      score = ACCEPTED_SCORE;
+    }
 
-            valid_removal =
-              _sol[v].is_valid_addition_for_tw(_input,
-                                               delivery_between_pd,
-                                               between_pd.begin(),
-                                               between_pd.end(),
-                                               r,
-                                               delivery_r + 1);
-          }
-        }
+    if (score > 0) {
+      for (const auto v : _modified_routes) {
+        current_sol[v] = _sol[v];
       }
-
-      if (best_gain < current_gain && valid_removal) {
-        best_gain = current_gain;
-        best_rank = r;
+      current_unassigned = _sol_state.unassigned;
+      current_indicators = sol_indicators;
+      _modified_routes.clear();
+    } else if (current_indicators < sol_indicators) {
+      // Rejected, back to current solution.
+      for (const auto v : _modified_routes) {
+        _sol[v] = current_sol[v];
+        _sol_state.setup(_sol[v]);
       }
+      _sol_state.unassigned = current_unassigned;
+      _modified_routes.clear();
     }
 
-    if (best_gain != NO_GAIN) {
-      routes_and_ranks.emplace_back(v, best_rank);
-    }
-  }
-
-  for (const auto& [v, r] : routes_and_ranks) {
-    _sol_state.unassigned.insert(_sol[v].route[r]);
-
-    const auto& current_job = _input.jobs[_sol[v].route[r]];
-    if (current_job.type == JOB_TYPE::SINGLE) {
-      _sol[v].remove(_input, r, 1);
-    } else {
-      assert(current_job.type == JOB_TYPE::PICKUP);
-      const auto delivery_r = _sol_state.matching_delivery_rank[v][r];
-      _sol_state.unassigned.insert(_sol[v].route[delivery_r]);
-
-      if (delivery_r == r + 1) {
-        _sol[v].remove(_input, r, 2);
-      } else {
-        std::vector<Index> between_pd(_sol[v].route.begin() + r + 1,
-                                      _sol[v].route.begin() + delivery_r);
-
-        _sol[v].replace(_input,
-                        _sol[v].delivery_in_range(r + 1, delivery_r),
-                        between_pd.begin(),
-                        between_pd.end(),
-                        r,
-                        delivery_r + 1);
-      }
+    for (auto* weight :
+         {&ruin_weights[ruin_rank], &recreate_weights[recreate_rank]}) {
+      *weight = std::max(MIN_WEIGHT,
+                         (1 - WEIGHT_REACTION) * *weight +
+                           WEIGHT_REACTION * score);
     }
   }
 }
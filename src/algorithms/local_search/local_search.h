@@ -10,8 +10,20 @@ All rights reserved (see LICENSE).
 
 */
 
+#include <array>
+#include <barrier>
+#include <exception>
+#include <initializer_list>
+#include <random>
+#include <thread>
+#include <variant>
+
+#include "algorithms/local_search/candidate_ranks.h"
+#include "algorithms/local_search/operator.h"
+#include "structures/vroom/solution/operator_stats.h"
 #include "structures/vroom/solution_indicators.h"
 #include "structures/vroom/solution_state.h"
+#include "utils/helpers.h"
 
 namespace vroom::ls {
 
@@ -41,10 +53,20 @@ private:
   const std::size_t _nb_vehicles;
 
   const unsigned _depth;
+  const unsigned _nb_threads;
   const Deadline _deadline;
+  // If set, search stops once that many moves have been applied.
+  const std::optional<unsigned> _max_moves;
 
+  unsigned _nb_moves{0};
   std::optional<unsigned> _completed_depth;
   std::vector<Index> _all_routes;
+  // Routes modified by moves applied in run_ls_step, only cleared on
+  // demand.
+  std::unordered_set<Index> _modified_routes;
+  // If set, only moves involving those routes are evaluated in the
+  // first local search step.
+  std::optional<std::unordered_set<Index>> _first_step_routes;
 
   utils::SolutionState _sol_state;
 
@@ -53,14 +75,213 @@ private:
   std::vector<Route>& _best_sol;
   utils::SolutionIndicators _best_sol_indicators;
 
+  // Best moves found in current step for each pair of routes, along
+  // with best priority increase and matching number of assigned tasks
+  // for operators involving a single route and unassigned jobs. Moves
+  // are stored by value in a slot per pair, allocated upon first use
+  // then reused for the whole search.
+  using OperatorSlot = std::variant<std::monostate,
+                                    UnassignedExchange,
+                                    CrossExchange,
+                                    MixedExchange,
+                                    TwoOpt,
+                                    ReverseTwoOpt,
+                                    Relocate,
+                                    OrOpt,
+                                    IntraExchange,
+                                    IntraCrossExchange,
+                                    IntraMixedExchange,
+                                    IntraRelocate,
+                                    IntraOrOpt,
+                                    IntraTwoOpt,
+                                    PDShift,
+                                    RouteExchange,
+                                    SwapStar,
+                                    RouteSplit,
+                                    PriorityReplace,
+                                    TSPFix>;
+  std::vector<std::vector<std::unique_ptr<OperatorSlot>>> _best_ops;
+  std::vector<std::vector<Eval>> _best_gains;
+  std::vector<Priority> _best_priorities;
+  std::vector<unsigned> _best_removals;
+
+  using RoutePairs = std::vector<std::pair<Index, Index>>;
+
+  // Below that many route pairs per thread, moves are evaluated
+  // sequentially.
+  static constexpr std::size_t MIN_PAIRS_PER_THREAD = 4;
+
+  // Statistics for the whole search and since all operators have last
+  // been enabled.
+  OperatorsStats _operators_stats;
+  OperatorsStats _recent_stats;
+
+  // With adaptive operators, once ADAPTIVE_WINDOW moves have been
+  // applied since all operators have last been enabled, operators
+  // that provided none of them are skipped. All operators are enabled
+  // again after ADAPTIVE_PERIOD applied moves, or before concluding
+  // that no improving move is left.
+  static constexpr unsigned ADAPTIVE_WINDOW = 20;
+  static constexpr unsigned ADAPTIVE_PERIOD = 100;
+  std::array<bool, OperatorName::MAX> _skipped_operators{};
+  unsigned _nb_recent_moves{0};
+
+  void add_stats(const OperatorsStats& stats);
+  void update_skipped_operators();
+  void enable_all_operators();
+
+  // Ruin and recreate iterations: a ruin operator removes jobs from
+  // current solution, they are inserted back using a recreate operator
+  // then a local search descent is run on modified routes. Operators
+  // are picked at random with weights adjusted to their recent
+  // success. Candidate solutions are accepted if within a decreasing
+  // threshold of best known cost (record-to-record travel).
+  enum class Ruin : std::uint8_t { RANDOM, WORST, RELATED, ROUTE };
+  static constexpr std::size_t NB_RUINS = 4;
+  enum class Recreate : std::uint8_t { REGRET, GREEDY, NOISY_GREEDY };
+  static constexpr std::size_t NB_RECREATES = 3;
+
+  // Number of jobs removed is drawn between MIN_RUIN and a share of
+  // assigned jobs, capped to MAX_RUIN.
+  static constexpr unsigned MIN_RUIN = 2;
+  static constexpr unsigned MAX_RUIN = 40;
+  static constexpr double MAX_RUIN_RATIO = 0.2;
+
+  // Noise on removal gains for worst removal, and on insertion costs
+  // for noisy greedy recreate.
+  static constexpr double WORST_RUIN_NOISE = 0.5;
+  static constexpr double RECREATE_NOISE = 0.2;
+  static constexpr double RECREATE_REGRET = 1.5;
+
+  // Initial allowed relative deviation from best known cost, linearly
+  // decreasing to zero as budget is spent.
+  static constexpr double RECORD_DEVIATION = 0.02;
+
+  // Operator weights are smoothed towards the score of each iteration.
+  static constexpr double NEW_BEST_SCORE = 33;
+  static constexpr double IMPROVEMENT_SCORE = 9;
+  static constexpr double ACCEPTED_SCORE = 13;
+  static constexpr double WEIGHT_REACTION = 0.1;
+  static constexpr double MIN_WEIGHT = 1;
+
+  // Seeded with search rank so that concurrent searches explore
+  // differently while runs with a moves budget stay reproducible.
+  std::mt19937 _rng;
+
+  // Best insertion of job j in route v, at index v * nb_jobs + j,
+  // with rank for single job or pickup and rank for delivery. Kept
+  // across try_job_additions calls and only valid while stored version
+  // matches _sol_state.route_versions[v].
+  std::vector<Eval> _insertion_evals;
+  std::vector<Index> _insertion_ranks;
+  std::vector<Index> _insertion_delivery_ranks;
+  std::vector<unsigned> _insertion_versions;
+
   std::unordered_set<Index> try_job_additions(const std::vector<Index>& routes,
-                                              double regret_coeff);
+                                              double regret_coeff,
+                                              double noise = 0);
+
+  // Evaluate moves for all given pairs of routes, only updating
+  // above entries for those pairs. Priority moves (UnassignedExchange
+  // and PriorityReplace) have to be evaluated first for all pairs.
+  void evaluate_priority_moves(const RoutePairs& s_t_pairs,
+                               OperatorsStats& stats);
+  void evaluate_moves(const RoutePairs& s_t_pairs, OperatorsStats& stats);
+
+  // Pairs evaluated by each thread, matching statistics and
+  // exceptions, when spreading evaluation over threads.
+  std::vector<RoutePairs> _thread_pairs;
+  std::vector<OperatorsStats> _thread_stats;
+  std::vector<std::exception_ptr> _thread_errors;
+
+  // Workers started upon construction when using several threads,
+  // the calling thread acting as thread 0. All threads wait on
+  // _threads_barrier before evaluating priority moves, before
+  // evaluating other moves and once done.
+  std::barrier<> _threads_barrier;
+  bool _stop_workers{false};
+  std::vector<std::jthread> _workers;
+
+  // Evaluate moves for all given pairs, spread over threads when
+  // there are enough pairs.
+  void evaluate_all_moves(const RoutePairs& s_t_pairs);
+
+  // Evaluate priority moves then other moves for pairs of thread t.
+  void evaluate_thread_moves(std::size_t t);
+
+  void run_worker(std::size_t t);
 
   void run_ls_step();
 
+  // Add to candidates all ranks r such that a neighbour of job at
+  // rank j, from the point of view of vehicle at rank profile_v, is
+  // at rank r + offset in route for vehicle v, for each offset.
+  void add_neighbour_ranks(CandidateRanks& candidates,
+                           Index profile_v,
+                           Index j,
+                           Index v,
+                           std::initializer_list<int> offsets) const {
+    for (const auto n : _input.job_neighbours(profile_v, j)) {
+      if (!_sol_state.is_in_route(n, v)) {
+        continue;
+      }
+      const int rank = _sol_state.job_ranks[n];
+      for (const auto offset : offsets) {
+        if (offset <= rank) {
+          candidates.add(rank - offset);
+        }
+      }
+    }
+  }
+
+  template <class Op>
+  void set_best_op(Index source,
+                   Index target,
+                   const Op& op,
+                   OperatorsStats& stats) {
+    ++stats[op.get_name()].valid_moves;
+
+    auto& slot = _best_ops[source][target];
+    if (slot == nullptr) {
+      slot = std::make_unique<OperatorSlot>(std::in_place_type<Op>, op);
+    } else {
+      slot->template emplace<Op>(op);
+    }
+  }
+
+  bool has_best_op(Index source, Index target) const {
+    const auto& slot = _best_ops[source][target];
+    return slot != nullptr && !std::holds_alternative<std::monostate>(*slot);
+  }
+
+  // Call f on move stored for this pair with its actual operator type
+  // so that calls are statically dispatched.
+  template <class F> void visit_best_op(Index source, Index target, F&& f) {
+    assert(has_best_op(source, target));
+    std::visit(
+      [&f](auto& op) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(op)>,
+                                      std::monostate>) {
+          f(op);
+        }
+      },
+      *_best_ops[source][target]);
+  }
+
+  void reset_best_op(Index source, Index target) {
+    if (auto& slot = _best_ops[source][target]; slot != nullptr) {
+      slot->template emplace<std::monostate>();
+    }
+  }
+
+  bool out_of_budget() const {
+    return (_deadline.has_value() && _deadline.value() < utils::now()) ||
+           (_max_moves.has_value() && _max_moves.value() <= _nb_moves);
+  }
+
   // Compute "cost" between route at rank v_target and job with rank r
-  // in route at rank v. Relies on
-  // _sol_state.cheapest_job_rank_in_routes_* being up to date.
+  // in route at rank v, based on cheapest jobs in route v_target from
+  // and to that job.
   Eval job_route_cost(Index v_target, Index v, Index r);
 
   // Compute lower bound for the cost of relocating job at rank r
@@ -69,17 +290,54 @@ private:
   Eval relocate_cost_lower_bound(Index v, Index r);
   Eval relocate_cost_lower_bound(Index v, Index r1, Index r2);
 
+  // True if job at rank r in route v (along with matching delivery
+  // for a pickup) can be removed.
+  bool is_valid_job_removal(Index v, Index r) const;
+
+  // Remove job at rank r in route v (along with matching delivery for
+  // a pickup) and mark it as unassigned, without updating
+  // _sol_state for route v.
+  void remove_job(Index v, Index r);
+
   void remove_from_routes();
 
+  // Remove up to nb_removals valid jobs using given operator and
+  // return modified routes.
+  std::unordered_set<Index> ruin(Ruin op, unsigned nb_removals);
+
+  void run_ruin_and_recreate();
+
 public:
   LocalSearch(const Input& input,
               std::vector<Route>& tw_sol,
               unsigned depth,
-              const Timeout& timeout);
+              const Timeout& timeout,
+              const std::optional<unsigned>& max_moves = std::nullopt,
+              unsigned nb_threads = 1,
+              unsigned seed = 0);
+
+  LocalSearch(const LocalSearch&) = delete;
+  LocalSearch& operator=(const LocalSearch&) = delete;
+
+  ~LocalSearch() {
+    if (!_workers.empty()) {
+      _stop_workers = true;
+      _threads_barrier.arrive_and_wait();
+    }
+  }
 
   utils::SolutionIndicators indicators() const;
 
+  const OperatorsStats& operators_stats() const {
+    return _operators_stats;
+  }
+
   void run();
+
+  // Run from a previous solution: unassigned jobs are inserted first,
+  // then the first step only searches moves involving given routes or
+  // routes modified upon insertion.
+  void reoptimize(std::unordered_set<Index> routes);
 };
 
 } // namespace vroom::ls
@@ -15,13 +15,6 @@ OperatorName Operator::get_name() const {
   return _name;
 }
 
-Eval Operator::gain() {
-  if (!gain_computed) {
-    this->compute_gain();
-  }
-  return stored_gain;
-}
-
 bool Operator::is_valid_for_source_range_bounds() const {
   const auto& s_v = _input.vehicles[s_vehicle];
   return s_v.ok_for_range_bounds(_sol_state.route_evals[s_vehicle] - s_gain);
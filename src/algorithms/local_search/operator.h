@@ -72,7 +72,14 @@ public:
 
   OperatorName get_name() const;
 
-  virtual Eval gain();
+  // Not virtual so that gain computation is statically dispatched
+  // when called on a concrete operator.
+  Eval gain() {
+    if (!gain_computed) {
+      this->compute_gain();
+    }
+    return stored_gain;
+  }
 
   virtual bool is_valid() = 0;
 
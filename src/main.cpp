@@ -31,7 +31,10 @@ int main(int argc, char** argv) {
   std::string router_arg;
   std::string limit_arg;
   std::string output_file;
-  unsigned exploration_level;
+  std::string exploration_arg;
+  unsigned exploration_level = vroom::DEFAULT_EXPLORATION_LEVEL;
+  unsigned max_moves = 0;
+  unsigned nb_neighbours = 0;
 
   cxxopts::Options options("vroom",
                            "VROOM Copyright (C) 2015-2025, Julien Coupey\n"
@@ -77,8 +80,23 @@ int main(int argc, char** argv) {
      cxxopts::value<unsigned>(cl_args.nb_threads)->default_value(std::to_string(vroom::DEFAULT_THREADS_NUMBER)))
     ("v,version", "output version information and exit")
     ("x,explore",
-     "exploration level to use (0..5)",
-     cxxopts::value<unsigned>(exploration_level)->default_value(std::to_string(vroom::DEFAULT_EXPLORATION_LEVEL)))
+     "exploration level to use (0..5), or auto to adjust to instance size and limit",
+     cxxopts::value<std::string>(exploration_arg)->default_value(std::to_string(vroom::DEFAULT_EXPLORATION_LEVEL)))
+    ("aggregate",
+     "merge compatible jobs sharing a location before solving",
+     cxxopts::value<bool>(cl_args.aggregate_jobs)->default_value("false"))
+    ("max-moves",
+     "stop each search after this many local search moves, ignoring limit, for results independent of timing and threads",
+     cxxopts::value<unsigned>(max_moves))
+    ("neighbours",
+     "only try inter-route moves putting jobs next to one of their 'neighbours' closest jobs",
+     cxxopts::value<unsigned>(nb_neighbours))
+    ("adaptive-operators",
+     "skip local search operators that recently provided no applied move",
+     cxxopts::value<bool>(cl_args.adaptive_operators)->default_value("false"))
+    ("ruin-recreate",
+     "spend remaining limit or moves budget on ruin and recreate iterations",
+     cxxopts::value<bool>(cl_args.ruin_and_recreate)->default_value("false"))
     ("stdin",
      "optional input positional arg",
      cxxopts::value<std::string>(cl_args.input));
@@ -123,6 +141,24 @@ int main(int argc, char** argv) {
                                            "' failed to parse");
     }
 
+    if (parsed_args.count("max-moves") != 0) {
+      cl_args.max_moves = max_moves;
+    }
+    if (parsed_args.count("neighbours") != 0) {
+      cl_args.nb_neighbours = nb_neighbours;
+    }
+
+    cl_args.auto_exploration = (exploration_arg == "auto");
+    try {
+      if (!cl_args.auto_exploration) {
+        exploration_level =
+          static_cast<unsigned>(std::stoul(exploration_arg));
+      }
+    } catch (const std::exception&) {
+      throw cxxopts::exceptions::exception("Argument '" + exploration_arg +
+                                           "' failed to parse");
+    }
+
     if (parsed_args.count("help") != 0) {
       std::cout << options.help({"Solving"}) << "\n";
       exit(0);
@@ -198,13 +234,20 @@ int main(int argc, char** argv) {
                                   cl_args.router,
                                   cl_args.apply_TSPFix);
     vroom::io::parse(problem_instance, cl_args.input, cl_args.geometry);
+    problem_instance.set_jobs_aggregation(cl_args.aggregate_jobs);
+    problem_instance.set_max_moves(cl_args.max_moves);
+    problem_instance.set_granularity(cl_args.nb_neighbours);
+    problem_instance.set_adaptive_operators(cl_args.adaptive_operators);
+    problem_instance.set_ruin_and_recreate(cl_args.ruin_and_recreate);
 
-    const vroom::Solution sol = (cl_args.check)
-                                  ? problem_instance.check(cl_args.nb_threads)
-                                  : problem_instance.solve(cl_args.nb_searches,
-                                                           cl_args.depth,
-                                                           cl_args.nb_threads,
-                                                           cl_args.timeout);
+    const vroom::Solution sol =
+      (cl_args.check) ? problem_instance.check(cl_args.nb_threads)
+      : (cl_args.auto_exploration)
+        ? problem_instance.solve_auto(cl_args.nb_threads, cl_args.timeout)
+        : problem_instance.solve(cl_args.nb_searches,
+                                 cl_args.depth,
+                                 cl_args.nb_threads,
+                                 cl_args.timeout);
 
     // Write solution.
     vroom::io::write_to_json(sol,
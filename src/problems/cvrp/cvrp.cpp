@@ -145,6 +145,7 @@ CVRP::CVRP(const Input& input) : VRP(input) {
 Solution CVRP::solve(const unsigned nb_searches,
                      const unsigned depth,
                      const unsigned nb_threads,
+                     const unsigned ls_nb_threads,
                      const Timeout& timeout) const {
   if (_input.vehicles.size() == 1 && !_input.has_skills() &&
       _input.zero_amount().empty() && !_input.has_shipments() &&
@@ -166,9 +167,20 @@ Solution CVRP::solve(const unsigned nb_searches,
   return VRP::solve<RawRoute, cvrp::LocalSearch>(nb_searches,
                                                  depth,
                                                  nb_threads,
+                                                 ls_nb_threads,
                                                  timeout,
                                                  homogeneous_parameters,
                                                  heterogeneous_parameters);
 }
 
+Solution CVRP::reoptimize(const unsigned depth,
+                          const unsigned nb_threads,
+                          const std::unordered_set<Index>& affected_vehicles,
+                          const Timeout& timeout) const {
+  return VRP::reoptimize<RawRoute, cvrp::LocalSearch>(depth,
+                                                      nb_threads,
+                                                      affected_vehicles,
+                                                      timeout);
+}
+
 } // namespace vroom
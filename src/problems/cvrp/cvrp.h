@@ -25,7 +25,13 @@ public:
   Solution solve(unsigned nb_searches,
                  unsigned depth,
                  unsigned nb_threads,
+                 unsigned ls_nb_threads,
                  const Timeout& timeout) const override;
+
+  Solution reoptimize(unsigned depth,
+                      unsigned nb_threads,
+                      const std::unordered_set<Index>& affected_vehicles,
+                      const Timeout& timeout) const override;
 };
 
 } // namespace vroom
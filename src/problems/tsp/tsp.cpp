@@ -131,7 +131,26 @@ TSP::TSP(const Input& input, std::vector<Index>&& job_ranks, Index vehicle_rank)
     }
   }
 
-  // Compute symmetrized matrix and update _is_symmetric flag.
+  if (_round_trip && v.has_symmetric_costs()) {
+    // Nothing to check, _matrix is used directly for the symmetric
+    // part of solving.
+    return;
+  }
+
+  for (Index i = 0; i < _matrix.size() && _is_symmetric; ++i) {
+    for (Index j = i + 1; j < _matrix.size(); ++j) {
+      if (_matrix[i][j] != _matrix[j][i]) {
+        _is_symmetric = false;
+        break;
+      }
+    }
+  }
+
+  if (_is_symmetric) {
+    return;
+  }
+
+  // Compute symmetrized matrix.
   _symmetrized_matrix = Matrix<UserCost>(_matrix.size());
 
   // Using symmetrization with max when only start or only end is
@@ -146,7 +165,6 @@ TSP::TSP(const Input& input, std::vector<Index>&& job_ranks, Index vehicle_rank)
   for (Index i = 0; i < _matrix.size(); ++i) {
     _symmetrized_matrix[i][i] = _matrix[i][i];
     for (Index j = i + 1; j < _matrix.size(); ++j) {
-      _is_symmetric = _is_symmetric && (_matrix[i][j] == _matrix[j][i]);
       const UserCost val = sym_f(_matrix[i][j], _matrix[j][i]);
       _symmetrized_matrix[i][j] = val;
       _symmetrized_matrix[j][i] = val;
@@ -159,7 +177,7 @@ UserCost TSP::cost(const std::list<Index>& tour) const {
 }
 
 UserCost TSP::symmetrized_cost(const std::list<Index>& tour) const {
-  return compute_cost(tour, _symmetrized_matrix);
+  return compute_cost(tour, symmetrized_matrix());
 }
 
 std::vector<Index> TSP::raw_solve(unsigned nb_threads,
@@ -169,7 +187,7 @@ std::vector<Index> TSP::raw_solve(unsigned nb_threads,
     timeout.has_value() ? utils::now() + timeout.value() : Deadline();
 
   // Applying heuristic.
-  const std::list<Index> christo_sol = tsp::christofides(_symmetrized_matrix);
+  const std::list<Index> christo_sol = tsp::christofides(symmetrized_matrix());
 
   Deadline sym_deadline = deadline;
   if (deadline.has_value() && !_is_symmetric) {
@@ -194,7 +212,7 @@ std::vector<Index> TSP::raw_solve(unsigned nb_threads,
   // solution in a small amount of time. All possible moves for the
   // different neighbourhoods are performed, stopping when reaching a
   // local minima.
-  tsp::LocalSearch sym_ls(_symmetrized_matrix,
+  tsp::LocalSearch sym_ls(symmetrized_matrix(),
                           std::make_pair(!_round_trip && _has_start && _has_end,
                                          _start),
                           christo_sol,
@@ -297,10 +315,18 @@ std::vector<Index> TSP::raw_solve(unsigned nb_threads,
 Solution TSP::solve(unsigned,
                     unsigned,
                     unsigned nb_threads,
+                    unsigned,
                     const Timeout& timeout) const {
   RawRoute r(_input, 0, 0);
   r.set_route(_input, raw_solve(nb_threads, timeout));
   return utils::format_solution(_input, {r});
 }
 
+Solution TSP::reoptimize(unsigned,
+                         const unsigned nb_threads,
+                         const std::unordered_set<Index>&,
+                         const Timeout& timeout) const {
+  return solve(0, 0, nb_threads, 1, timeout);
+}
+
 } // namespace vroom
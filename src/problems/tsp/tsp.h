@@ -31,9 +31,14 @@ private:
   const bool _has_end;
   Index _end;
   Matrix<UserCost> _matrix;
+  // Only populated if _matrix is not symmetric.
   Matrix<UserCost> _symmetrized_matrix;
   bool _round_trip;
 
+  const Matrix<UserCost>& symmetrized_matrix() const {
+    return _is_symmetric ? _matrix : _symmetrized_matrix;
+  }
+
   UserCost cost(const std::list<Index>& tour) const;
 
   UserCost symmetrized_cost(const std::list<Index>& tour) const;
@@ -47,7 +52,14 @@ public:
   Solution solve(unsigned,
                  unsigned,
                  unsigned nb_threads,
+                 unsigned,
                  const Timeout& timeout) const override;
+
+  // No previous solution is used for a plain TSP.
+  Solution reoptimize(unsigned,
+                      unsigned nb_threads,
+                      const std::unordered_set<Index>&,
+                      const Timeout& timeout) const override;
 };
 
 } // namespace vroom
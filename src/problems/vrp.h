@@ -11,9 +11,12 @@ All rights reserved (see LICENSE).
 */
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <mutex>
 #include <numeric>
 #include <ranges>
+#include <semaphore>
 #include <set>
 #include <thread>
 
@@ -49,15 +52,22 @@ template <class Route> struct SolvingContext {
   std::vector<Index> vehicles_ranks;
   std::vector<std::vector<Route>> solutions;
   std::vector<utils::SolutionIndicators> sol_indicators;
+  std::vector<OperatorsStats> operators_stats;
 
-  std::set<utils::SolutionIndicators> heuristic_indicators;
-  std::mutex heuristic_indicators_m;
+  // Heuristic indicators per search, along with an open addressing
+  // table of search ranks keyed on those indicators. Slots store rank
+  // + 1, 0 being empty, and are at least twice as many as searches.
+  std::vector<utils::SolutionIndicators> heuristic_indicators;
+  std::vector<std::atomic<unsigned>> heuristic_ranks;
 
   SolvingContext(const Input& input, unsigned nb_searches)
     : init_sol(set_init_sol<Route>(input, init_assigned)),
       vehicles_ranks(input.vehicles.size()),
       solutions(nb_searches, init_sol),
-      sol_indicators(nb_searches) {
+      sol_indicators(nb_searches),
+      operators_stats(nb_searches),
+      heuristic_indicators(nb_searches),
+      heuristic_ranks(std::bit_ceil(2 * nb_searches)) {
 
     // Deduce unassigned jobs from initial solution.
     std::ranges::copy_if(std::views::iota(0u, input.jobs.size()),
@@ -70,25 +80,36 @@ template <class Route> struct SolvingContext {
     std::iota(vehicles_ranks.begin(), vehicles_ranks.end(), 0);
   }
 
+  // Lock-free insertion, each rank is only inserted once.
   bool heuristic_solution_already_found(unsigned rank) {
     assert(rank < sol_indicators.size());
-    const std::scoped_lock<std::mutex> lock(heuristic_indicators_m);
-    const auto [dummy, insertion_ok] =
-      heuristic_indicators.insert(sol_indicators[rank]);
-
-    return !insertion_ok;
+    heuristic_indicators[rank] = sol_indicators[rank];
+    const auto& indicators = heuristic_indicators[rank];
+
+    const auto mask = heuristic_ranks.size() - 1;
+    for (auto slot = indicators.hash() & mask;; slot = (slot + 1) & mask) {
+      // Release on success publishes heuristic_indicators[rank] to
+      // threads reading this slot.
+      unsigned entry = 0;
+      if (heuristic_ranks[slot]
+            .compare_exchange_strong(entry,
+                                     rank + 1,
+                                     std::memory_order_release,
+                                     std::memory_order_acquire)) {
+        return false;
+      }
+      if (heuristic_indicators[entry - 1] == indicators) {
+        return true;
+      }
+    }
   }
 };
 
-template <class Route, class LocalSearch>
-void run_single_search(const Input& input,
-                       const HeuristicParameters& p,
-                       const unsigned rank,
-                       const unsigned depth,
-                       const Timeout& search_time,
-                       SolvingContext<Route>& context) {
-  const auto heuristic_start = utils::now();
-
+template <class Route>
+void run_heuristic(const Input& input,
+                   const HeuristicParameters& p,
+                   const unsigned rank,
+                   SolvingContext<Route>& context) {
   Eval h_eval;
   switch (p.heuristic) {
   case HEURISTIC::BASIC:
@@ -144,12 +165,47 @@ void run_single_search(const Input& input,
     }
   }
 
-  // Check if heuristic solution has been encountered before.
   context.sol_indicators[rank] =
     utils::SolutionIndicators(input, context.solutions[rank]);
+}
+
+template <class Route, class LocalSearch>
+void run_local_search(const Input& input,
+                      const unsigned rank,
+                      const unsigned depth,
+                      const unsigned nb_threads,
+                      const Timeout& search_time,
+                      SolvingContext<Route>& context) {
+  LocalSearch ls(input,
+                 context.solutions[rank],
+                 depth,
+                 search_time,
+                 input.max_moves(),
+                 nb_threads,
+                 rank);
+  ls.run();
+
+  // Store solution indicators.
+  context.sol_indicators[rank] = ls.indicators();
+  context.operators_stats[rank] = ls.operators_stats();
+}
+
+template <class Route, class LocalSearch>
+void run_single_search(const Input& input,
+                       const HeuristicParameters& p,
+                       const unsigned rank,
+                       const unsigned depth,
+                       const unsigned nb_threads,
+                       const Timeout& search_time,
+                       SolvingContext<Route>& context) {
+  const auto heuristic_start = utils::now();
+
+  run_heuristic<Route>(input, p, rank, context);
 
   const auto heuristic_end = utils::now();
 
+  // Check if heuristic solution has been encountered before.
+
   if (context.heuristic_solution_already_found(rank)) {
     // Duplicate heuristic solution, so skip local search.
     return;
@@ -169,12 +225,12 @@ void run_single_search(const Input& input,
     ls_search_time = search_time.value() - heuristic_time;
   }
 
-  // Local search phase.
-  LocalSearch ls(input, context.solutions[rank], depth, ls_search_time);
-  ls.run();
-
-  // Store solution indicators.
-  context.sol_indicators[rank] = ls.indicators();
+  run_local_search<Route, LocalSearch>(input,
+                                      rank,
+                                      depth,
+                                      nb_threads,
+                                      ls_search_time,
+                                      context);
 }
 
 class VRP {
@@ -187,6 +243,7 @@ protected:
     unsigned nb_searches,
     const unsigned depth,
     const unsigned nb_threads,
+    const unsigned ls_nb_threads,
     const Timeout& timeout,
     const std::vector<HeuristicParameters>& homogeneous_parameters,
     const std::vector<HeuristicParameters>& heterogeneous_parameters) const {
@@ -199,69 +256,133 @@ protected:
 
     SolvingContext<Route> context(_input, nb_searches);
 
-    std::exception_ptr ep = nullptr;
-    std::mutex ep_m;
-
-    const auto actual_nb_threads = std::min(nb_searches, nb_threads);
+    // Each search uses ls_nb_threads threads to evaluate moves, other
+    // threads are used to run searches concurrently.
+    assert(ls_nb_threads != 0);
+    const auto actual_nb_threads =
+      std::min(nb_searches, std::max(1u, nb_threads / ls_nb_threads));
     assert(actual_nb_threads <= 32);
-    std::counting_semaphore<32> semaphore(actual_nb_threads);
-
-    Timeout search_time;
-    if (timeout.has_value()) {
-      // Max number of solving per thread.
-      const auto dv = std::div(static_cast<long>(nb_searches),
-                               static_cast<long>(actual_nb_threads));
-      const unsigned max_solving_number = dv.quot + ((dv.rem == 0) ? 0 : 1);
-      search_time = timeout.value() / max_solving_number;
-    }
 
-    auto run_solving = [&context,
-                        &semaphore,
-                        &search_time,
-                        &parameters,
-                        &timeout,
-                        &ep,
-                        &ep_m,
-                        depth,
-                        this](const unsigned rank) {
-      semaphore.acquire();
-      try {
-        run_single_search<Route, LocalSearch>(_input,
-                                              parameters[rank],
-                                              rank,
-                                              depth,
-                                              search_time,
-                                              context);
-      } catch (...) {
-        const std::scoped_lock<std::mutex> lock(ep_m);
-        ep = std::current_exception();
+    // Run search for all ranks, at most actual_nb_threads at a time.
+    auto run_searches = [nb_searches, actual_nb_threads](const auto& search) {
+      std::exception_ptr ep = nullptr;
+      std::mutex ep_m;
+      std::counting_semaphore<32> semaphore(actual_nb_threads);
+
+      auto run_search = [&search, &semaphore, &ep, &ep_m](const unsigned rank) {
+        semaphore.acquire();
+        try {
+          search(rank);
+        } catch (...) {
+          const std::scoped_lock<std::mutex> lock(ep_m);
+          ep = std::current_exception();
+        }
+        semaphore.release();
+      };
+
+      std::vector<std::jthread> solving_threads;
+      solving_threads.reserve(nb_searches);
+
+      for (unsigned i = 0; i < nb_searches; ++i) {
+        solving_threads.emplace_back(run_search, i);
+      }
+
+      for (auto& t : solving_threads) {
+        t.join();
       }
-      semaphore.release();
-    };
 
-    std::vector<std::jthread> solving_threads;
-    solving_threads.reserve(nb_searches);
+      if (ep != nullptr) {
+        std::rethrow_exception(ep);
+      }
+    };
 
-    for (unsigned i = 0; i < nb_searches; ++i) {
-      solving_threads.emplace_back(run_solving, i);
-    }
+    if (_input.max_moves().has_value()) {
+      // Deterministic solving: timeout is ignored and duplicate
+      // heuristic solutions are resolved in rank order once all
+      // heuristics are done, so that the outcome does not depend on
+      // threads scheduling.
+      run_searches([&context, &parameters, this](const unsigned rank) {
+        run_heuristic<Route>(_input, parameters[rank], rank, context);
+      });
+
+      std::vector<bool> duplicate(nb_searches);
+      for (unsigned rank = 0; rank < nb_searches; ++rank) {
+        duplicate[rank] = context.heuristic_solution_already_found(rank);
+      }
 
-    for (auto& t : solving_threads) {
-      t.join();
-    }
+      run_searches([&context, &duplicate, depth, ls_nb_threads, this](
+                     const unsigned rank) {
+        if (!duplicate[rank]) {
+          run_local_search<Route, LocalSearch>(_input,
+                                               rank,
+                                               depth,
+                                               ls_nb_threads,
+                                               Timeout(),
+                                               context);
+        }
+      });
+    } else {
+      Timeout search_time;
+      if (timeout.has_value()) {
+        // Max number of solving per thread.
+        const auto dv = std::div(static_cast<long>(nb_searches),
+                                 static_cast<long>(actual_nb_threads));
+        const unsigned max_solving_number =
+          dv.quot + ((dv.rem == 0) ? 0 : 1);
+        search_time = timeout.value() / max_solving_number;
+      }
 
-    if (ep != nullptr) {
-      std::rethrow_exception(ep);
+      run_searches(
+        [&context, &parameters, &search_time, depth, ls_nb_threads, this](
+          const unsigned rank) {
+          run_single_search<Route, LocalSearch>(_input,
+                                                parameters[rank],
+                                                rank,
+                                                depth,
+                                                ls_nb_threads,
+                                                search_time,
+                                                context);
+        });
     }
 
     auto best_indic = std::min_element(context.sol_indicators.cbegin(),
                                        context.sol_indicators.cend());
 
-    return utils::
+    auto sol = utils::
       format_solution(_input,
                       context.solutions[std::distance(context.sol_indicators
                                                         .cbegin(),
                                                       best_indic)]);
+
+    for (const auto& stats : context.operators_stats) {
+      sol.summary.operators_stats += stats;
+    }
+
+    return sol;
+  }
+
+  template <class Route, class LocalSearch>
+  Solution reoptimize(const unsigned depth,
+                      const unsigned nb_threads,
+                      const std::unordered_set<Index>& affected_vehicles,
+                      const Timeout& timeout) const {
+    // Previous solution is provided as initial routes.
+    assert(_input.has_initial_routes());
+    std::unordered_set<Index> init_assigned;
+    auto sol = set_init_sol<Route>(_input, init_assigned);
+
+    LocalSearch ls(_input,
+                   sol,
+                   depth,
+                   _input.max_moves().has_value() ? Timeout() : timeout,
+                   _input.max_moves(),
+                   nb_threads);
+    ls.reoptimize(affected_vehicles);
+
+    auto solution = utils::format_solution(_input, sol);
+    solution.summary.operators_stats = ls.operators_stats();
+
+    return solution;
   }
 
 public:
@@ -272,7 +393,14 @@ public:
   virtual Solution solve(unsigned nb_searches,
                          unsigned depth,
                          unsigned nb_threads,
+                         unsigned ls_nb_threads,
                          const Timeout& timeout) const = 0;
+
+  virtual Solution
+  reoptimize(unsigned depth,
+             unsigned nb_threads,
+             const std::unordered_set<Index>& affected_vehicles,
+             const Timeout& timeout) const = 0;
 };
 
 } // namespace vroom
@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class IntraCrossExchange : public cvrp::IntraCrossExchange {
+class IntraCrossExchange final : public cvrp::IntraCrossExchange {
 private:
   TWRoute& _tw_s_route;
 
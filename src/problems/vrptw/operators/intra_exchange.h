@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class IntraExchange : public cvrp::IntraExchange {
+class IntraExchange final : public cvrp::IntraExchange {
 private:
   TWRoute& _tw_s_route;
 
@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class IntraMixedExchange : public cvrp::IntraMixedExchange {
+class IntraMixedExchange final : public cvrp::IntraMixedExchange {
 private:
   TWRoute& _tw_s_route;
 
@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class IntraOrOpt : public cvrp::IntraOrOpt {
+class IntraOrOpt final : public cvrp::IntraOrOpt {
 private:
   TWRoute& _tw_s_route;
 
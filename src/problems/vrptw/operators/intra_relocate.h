@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class IntraRelocate : public cvrp::IntraRelocate {
+class IntraRelocate final : public cvrp::IntraRelocate {
 private:
   TWRoute& _tw_s_route;
 
@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class IntraTwoOpt : public cvrp::IntraTwoOpt {
+class IntraTwoOpt final : public cvrp::IntraTwoOpt {
 private:
   TWRoute& _tw_s_route;
 
@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class MixedExchange : public cvrp::MixedExchange {
+class MixedExchange final : public cvrp::MixedExchange {
 private:
   TWRoute& _tw_s_route;
   TWRoute& _tw_t_route;
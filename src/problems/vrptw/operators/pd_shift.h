@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class PDShift : public cvrp::PDShift {
+class PDShift final : public cvrp::PDShift {
 private:
   TWRoute& _tw_s_route;
   TWRoute& _tw_t_route;
@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class PriorityReplace : public cvrp::PriorityReplace {
+class PriorityReplace final : public cvrp::PriorityReplace {
 private:
   TWRoute& _tw_s_route;
 
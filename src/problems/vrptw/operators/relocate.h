@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class Relocate : public cvrp::Relocate {
+class Relocate final : public cvrp::Relocate {
 private:
   TWRoute& _tw_s_route;
   TWRoute& _tw_t_route;
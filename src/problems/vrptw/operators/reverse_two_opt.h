@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class ReverseTwoOpt : public cvrp::ReverseTwoOpt {
+class ReverseTwoOpt final : public cvrp::ReverseTwoOpt {
 private:
   TWRoute& _tw_s_route;
   TWRoute& _tw_t_route;
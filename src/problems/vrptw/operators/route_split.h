@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class RouteSplit : public cvrp::RouteSplit {
+class RouteSplit final : public cvrp::RouteSplit {
 private:
   TWRoute& _tw_s_route;
   std::vector<TWRoute>& _tw_sol;
@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class SwapStar : public cvrp::SwapStar {
+class SwapStar final : public cvrp::SwapStar {
 private:
   TWRoute& _tw_s_route;
   TWRoute& _tw_t_route;
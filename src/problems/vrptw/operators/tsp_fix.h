@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class TSPFix : public cvrp::TSPFix {
+class TSPFix final : public cvrp::TSPFix {
 private:
   TWRoute& _tw_s_route;
 
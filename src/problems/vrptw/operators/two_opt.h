@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class TwoOpt : public cvrp::TwoOpt {
+class TwoOpt final : public cvrp::TwoOpt {
 private:
   TWRoute& _tw_s_route;
   TWRoute& _tw_t_route;
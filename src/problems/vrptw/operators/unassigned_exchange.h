@@ -14,7 +14,7 @@ All rights reserved (see LICENSE).
 
 namespace vroom::vrptw {
 
-class UnassignedExchange : public cvrp::UnassignedExchange {
+class UnassignedExchange final : public cvrp::UnassignedExchange {
 private:
   TWRoute& _tw_s_route;
 
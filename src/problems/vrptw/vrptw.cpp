@@ -143,13 +143,25 @@ VRPTW::VRPTW(const Input& input) : VRP(input) {
 Solution VRPTW::solve(const unsigned nb_searches,
                       const unsigned depth,
                       const unsigned nb_threads,
+                      const unsigned ls_nb_threads,
                       const Timeout& timeout) const {
   return VRP::solve<TWRoute, vrptw::LocalSearch>(nb_searches,
                                                  depth,
                                                  nb_threads,
+                                                 ls_nb_threads,
                                                  timeout,
                                                  homogeneous_parameters,
                                                  heterogeneous_parameters);
 }
 
+Solution VRPTW::reoptimize(const unsigned depth,
+                           const unsigned nb_threads,
+                           const std::unordered_set<Index>& affected_vehicles,
+                           const Timeout& timeout) const {
+  return VRP::reoptimize<TWRoute, vrptw::LocalSearch>(depth,
+                                                      nb_threads,
+                                                      affected_vehicles,
+                                                      timeout);
+}
+
 } // namespace vroom
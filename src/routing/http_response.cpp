@@ -0,0 +1,224 @@
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+#include "routing/http_response.h"
+#include "utils/exception.h"
+
+namespace vroom::routing {
+
+constexpr std::size_t INFLATE_CHUNK_SIZE = 1 << 16;
+
+// Parse size at start of str, trailing characters are ignored.
+inline std::size_t parse_size(std::string_view str, int base) {
+  std::size_t size = 0;
+  const auto [ptr, ec] =
+    std::from_chars(str.data(), str.data() + str.size(), size, base);
+  if (ec != std::errc()) {
+    throw RoutingException("Invalid routing response.");
+  }
+  return size;
+}
+
+HttpResponse::~HttpResponse() {
+  if (_compressed) {
+    inflateEnd(&_z_stream);
+  }
+}
+
+void HttpResponse::parse_headers() {
+  bool chunked = false;
+
+  // Skip status line.
+  auto line_start = _headers.find("\r\n");
+  while (line_start != std::string::npos) {
+    line_start += 2;
+    const auto line_end = _headers.find("\r\n", line_start);
+    if (line_end == std::string::npos || line_end == line_start) {
+      break;
+    }
+
+    const auto colon = _headers.find(':', line_start);
+    if (colon < line_end) {
+      std::string name = _headers.substr(line_start, colon - line_start);
+      std::ranges::transform(name, name.begin(), [](unsigned char c) {
+        return std::tolower(c);
+      });
+
+      std::string value = _headers.substr(colon + 1, line_end - colon - 1);
+      std::ranges::transform(value, value.begin(), [](unsigned char c) {
+        return std::tolower(c);
+      });
+      value.erase(0, value.find_first_not_of(" \t"));
+      value.erase(value.find_last_not_of(" \t") + 1);
+
+      if (name == "content-length") {
+        _has_content_length = true;
+        _remaining = parse_size(value, 10);
+      } else if (name == "transfer-encoding") {
+        chunked = value.find("chunked") != std::string::npos;
+      } else if (name == "content-encoding") {
+        if (value == "gzip" || value == "x-gzip" || value == "deflate") {
+          _compressed = true;
+        } else if (value != "identity") {
+          throw RoutingException("Unsupported routing response encoding: " +
+                                 value + ".");
+        }
+      }
+    }
+
+    line_start = line_end;
+  }
+
+  if (_compressed) {
+    // Automatic detection of gzip or zlib header.
+    constexpr int window_bits = MAX_WBITS + 32;
+    if (inflateInit2(&_z_stream, window_bits) != Z_OK) {
+      _compressed = false;
+      throw RoutingException("Failed to decompress routing response.");
+    }
+  }
+
+  if (chunked) {
+    // Chunk sizes take precedence over Content-Length.
+    _has_content_length = false;
+    _state = STATE::CHUNK_SIZE;
+  } else {
+    _state = (_has_content_length && _remaining == 0) ? STATE::DONE
+                                                      : STATE::BODY;
+  }
+}
+
+void HttpResponse::decode(const char* data, std::size_t len) {
+  if (!_compressed) {
+    _body.append(data, len);
+    return;
+  }
+
+  _z_stream.next_in =
+    reinterpret_cast<Bytef*>(const_cast<char*>(data)); // NOLINT
+  _z_stream.avail_in = static_cast<uInt>(len);
+
+  while (_z_stream.avail_in > 0) {
+    // Inflate straight to the end of body.
+    const auto previous_size = _body.size();
+    _body.resize(previous_size + INFLATE_CHUNK_SIZE);
+    _z_stream.next_out =
+      reinterpret_cast<Bytef*>(_body.data() + previous_size); // NOLINT
+    _z_stream.avail_out = INFLATE_CHUNK_SIZE;
+
+    const auto ret = inflate(&_z_stream, Z_NO_FLUSH);
+    _body.resize(previous_size + INFLATE_CHUNK_SIZE - _z_stream.avail_out);
+
+    if (ret == Z_STREAM_END) {
+      // Ignore anything after compressed stream, e.g. last chunk.
+      _state = STATE::DONE;
+      break;
+    }
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      throw RoutingException("Failed to decompress routing response.");
+    }
+  }
+}
+
+void HttpResponse::add(const char* data, std::size_t len) {
+  while (len > 0 && _state != STATE::DONE) {
+    switch (_state) {
+    case STATE::HEADERS: {
+      // Headers end can be split across two reads.
+      const auto search_start =
+        (_headers.size() < 3) ? 0 : _headers.size() - 3;
+      _headers.append(data, len);
+
+      const auto end = _headers.find("\r\n\r\n", search_start);
+      if (end == std::string::npos) {
+        return;
+      }
+
+      // Remaining bytes in current data are body content.
+      const auto headers_size = end + 4;
+      const auto body_size = _headers.size() - headers_size;
+      data += len - body_size;
+      len = body_size;
+      _headers.resize(headers_size);
+
+      parse_headers();
+      break;
+    }
+    case STATE::BODY: {
+      const auto size = _has_content_length ? std::min(len, _remaining) : len;
+      decode(data, size);
+      data += size;
+      len -= size;
+
+      if (_has_content_length) {
+        _remaining -= size;
+        if (_remaining == 0) {
+          _state = STATE::DONE;
+        }
+      }
+      break;
+    }
+    case STATE::CHUNK_SIZE: {
+      const auto* const line_end =
+        static_cast<const char*>(std::memchr(data, '\n', len));
+      if (line_end == nullptr) {
+        _chunk_size_line.append(data, len);
+        return;
+      }
+
+      const auto size = static_cast<std::size_t>(line_end - data);
+      _chunk_size_line.append(data, size);
+      data += size + 1;
+      len -= size + 1;
+
+      // Chunk extensions are ignored.
+      _remaining = parse_size(_chunk_size_line, 16);
+      _chunk_size_line.clear();
+
+      _state = (_remaining == 0) ? STATE::DONE : STATE::CHUNK_DATA;
+      break;
+    }
+    case STATE::CHUNK_DATA: {
+      const auto size = std::min(len, _remaining);
+      decode(data, size);
+      data += size;
+      len -= size;
+      _remaining -= size;
+
+      if (_remaining == 0 && _state != STATE::DONE) {
+        // Skip CRLF after chunk data.
+        _remaining = 2;
+        _state = STATE::CHUNK_DATA_END;
+      }
+      break;
+    }
+    case STATE::CHUNK_DATA_END: {
+      const auto size = std::min(len, _remaining);
+      data += size;
+      len -= size;
+      _remaining -= size;
+
+      if (_remaining == 0) {
+        _state = STATE::CHUNK_SIZE;
+      }
+      break;
+    }
+    case STATE::DONE:
+      break;
+    }
+  }
+}
+
+} // namespace vroom::routing
@@ -0,0 +1,153 @@
+#ifndef HTTP_RESPONSE_H
+#define HTTP_RESPONSE_H
+
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <zlib.h>
+
+namespace vroom::routing {
+
+// Decodes an HTTP response while raw bytes are received: headers are
+// parsed first, then body content is de-chunked and decompressed on
+// the fly depending on Transfer-Encoding and Content-Encoding.
+class HttpResponse {
+private:
+  enum class STATE : std::uint8_t {
+    HEADERS,
+    BODY,
+    CHUNK_SIZE,
+    CHUNK_DATA,
+    CHUNK_DATA_END,
+    DONE
+  };
+
+  STATE _state{STATE::HEADERS};
+  std::string _headers;
+  std::string _chunk_size_line;
+  std::string _body;
+
+  // Remaining bytes expected for current chunk, or for whole body if
+  // a Content-Length header is provided.
+  std::size_t _remaining{0};
+  bool _has_content_length{false};
+  bool _compressed{false};
+  z_stream _z_stream{};
+
+  void parse_headers();
+
+  void decode(const char* data, std::size_t len);
+
+public:
+  HttpResponse() = default;
+
+  HttpResponse(const HttpResponse&) = delete;
+  HttpResponse& operator=(const HttpResponse&) = delete;
+
+  ~HttpResponse();
+
+  void add(const char* data, std::size_t len);
+
+  // True once body has been fully received, based on Content-Length,
+  // last chunk or end of compressed stream.
+  bool complete() const {
+    return _state == STATE::DONE;
+  }
+
+  std::string& body() {
+    return _body;
+  }
+};
+
+// Input stream for rapidjson over the body of an HTTP response. More
+// data is received from the connection whenever parsing reaches the
+// end of the body received so far, and consumed data is dropped.
+class ResponseStream {
+private:
+  std::string& _body;
+  // Receives more data into response body, returns false once no
+  // more data is expected.
+  const std::function<bool()> _receive;
+  bool _more;
+  std::size_t _pos{0};
+  std::size_t _consumed{0};
+
+  bool fill() {
+    _consumed += _body.size();
+    _body.clear();
+    _pos = 0;
+    while (_body.empty() && _more) {
+      _more = _receive();
+    }
+    return !_body.empty();
+  }
+
+public:
+  using Ch = char;
+
+  ResponseStream(HttpResponse& response, std::function<bool()> receive)
+    : _body(response.body()),
+      _receive(std::move(receive)),
+      _more(!response.complete()) {
+  }
+
+  Ch Peek() {
+    if (_pos == _body.size() && !fill()) {
+      return '\0';
+    }
+    return _body[_pos];
+  }
+
+  Ch Take() {
+    const Ch c = Peek();
+    if (c != '\0') {
+      ++_pos;
+    }
+    return c;
+  }
+
+  std::size_t Tell() const {
+    return _consumed + _pos;
+  }
+
+  // Receive whole response body, only valid if nothing has been
+  // consumed yet.
+  std::string& read_all() {
+    assert(Tell() == 0);
+    while (_more) {
+      _more = _receive();
+    }
+    return _body;
+  }
+
+  // Required by rapidjson stream concept, not used for parsing.
+  Ch* PutBegin() {
+    assert(false);
+    return nullptr;
+  }
+  void Put(Ch) {
+    assert(false);
+  }
+  void Flush() {
+    assert(false);
+  }
+  std::size_t PutEnd(Ch*) {
+    assert(false);
+    return 0;
+  }
+};
+
+} // namespace vroom::routing
+
+#endif
@@ -12,7 +12,9 @@ All rights reserved (see LICENSE).
 #include <asio.hpp>
 #include <asio/ssl.hpp>
 
+#include "routing/http_response.h"
 #include "routing/http_wrapper.h"
+#include "routing/matrices_handler.h"
 
 using asio::ip::tcp;
 
@@ -20,6 +22,10 @@ namespace vroom::routing {
 
 const std::string HttpWrapper::HTTPS_PORT = "443";
 
+// Read buffer size grows from min to max value while reads fill it.
+constexpr std::size_t MIN_READ_BUFFER_SIZE = 1 << 14;
+constexpr std::size_t MAX_READ_BUFFER_SIZE = 1 << 20;
+
 HttpWrapper::HttpWrapper(const std::string& profile,
                          Server server,
                          std::string matrix_service,
@@ -36,39 +42,45 @@ HttpWrapper::HttpWrapper(const std::string& profile,
     _routing_args(std::move(routing_args)) {
 }
 
-void set_response(auto& s, std::string& response) {
-  char buf[512]; // NOLINT
+// Perform one read into response, growing buffer if it gets filled.
+// Returns false once no more data is expected.
+bool read_response(auto& s, HttpResponse& response, std::vector<char>& buf) {
   std::error_code error;
-  for (;;) {
-    const std::size_t len = s.read_some(asio::buffer(buf), error);
-    response.append(buf, len); // NOLINT
-    if (error == asio::error::eof) {
-      // Connection closed cleanly.
-      break;
-    }
-    if (error) {
-      throw std::system_error(error);
-    }
+  const std::size_t len = s.read_some(asio::buffer(buf), error);
+  response.add(buf.data(), len);
+  if (error == asio::error::eof) {
+    // Connection closed cleanly.
+    return false;
   }
+  if (error) {
+    throw std::system_error(error);
+  }
+  if (len == buf.size() && buf.size() < MAX_READ_BUFFER_SIZE) {
+    buf.resize(2 * buf.size());
+  }
+  return !response.complete();
 }
 
-std::string get_json(const std::string& response) {
-  // Removing headers.
-  auto start = response.find('{');
+std::string get_json(std::string& body) {
+  // Trim anything around JSON content.
+  auto start = body.find('{');
   if (start == std::string::npos) {
-    throw RoutingException("Invalid routing response: " + response);
+    throw RoutingException("Invalid routing response: " + body);
   }
-  auto end = response.rfind('}');
+  auto end = body.rfind('}');
   if (end == std::string::npos) {
-    throw RoutingException("Invalid routing response: " + response);
+    throw RoutingException("Invalid routing response: " + body);
   }
 
-  return response.substr(start, end - start + 1);
-}
+  body.erase(end + 1);
+  body.erase(0, start);
 
-std::string HttpWrapper::send_then_receive(const std::string& query) const {
-  std::string response;
+  return std::move(body);
+}
 
+void HttpWrapper::send_then_receive(
+  const std::string& query,
+  const std::function<void(ResponseStream&)>& parse) const {
   try {
     asio::io_context io_context;
 
@@ -79,18 +91,20 @@ std::string HttpWrapper::send_then_receive(const std::string& query) const {
 
     asio::write(s, asio::buffer(query));
 
-    set_response(s, response);
+    HttpResponse response;
+    std::vector<char> buf(MIN_READ_BUFFER_SIZE);
+    ResponseStream stream(response,
+                          [&] { return read_response(s, response, buf); });
+    parse(stream);
   } catch (std::system_error&) {
     throw RoutingException("Failed to connect to " + _server.host + ":" +
                            _server.port);
   }
-
-  return get_json(response);
 }
 
-std::string HttpWrapper::ssl_send_then_receive(const std::string& query) const {
-  std::string response;
-
+void HttpWrapper::ssl_send_then_receive(
+  const std::string& query,
+  const std::function<void(ResponseStream&)>& parse) const {
   try {
     asio::io_context io_context;
 
@@ -104,18 +118,33 @@ std::string HttpWrapper::ssl_send_then_receive(const std::string& query) const {
 
     asio::write(ssock, asio::buffer(query));
 
-    set_response(ssock, response);
+    HttpResponse response;
+    std::vector<char> buf(MIN_READ_BUFFER_SIZE);
+    ResponseStream stream(response,
+                          [&] { return read_response(ssock, response, buf); });
+    parse(stream);
   } catch (std::system_error&) {
     throw RoutingException("Failed to connect to " + _server.host + ":" +
                            _server.port);
   }
+}
 
-  return get_json(response);
+void HttpWrapper::run_query(
+  const std::string& query,
+  const std::function<void(ResponseStream&)>& parse) const {
+  if (_server.port == HTTPS_PORT) {
+    ssl_send_then_receive(query, parse);
+  } else {
+    send_then_receive(query, parse);
+  }
 }
 
 std::string HttpWrapper::run_query(const std::string& query) const {
-  return (_server.port == HTTPS_PORT) ? ssl_send_then_receive(query)
-                                      : send_then_receive(query);
+  std::string json_string;
+  run_query(query, [&](ResponseStream& stream) {
+    json_string = get_json(stream.read_all());
+  });
+  return json_string;
 }
 
 void HttpWrapper::parse_response(rapidjson::Document& json_result,
@@ -126,59 +155,59 @@ void HttpWrapper::parse_response(rapidjson::Document& json_result,
   }
 }
 
-Matrices HttpWrapper::get_matrices(const std::vector<Location>& locs) const {
+Matrices HttpWrapper::get_matrices(const std::vector<Location>& locs,
+                                   unsigned nb_thread) const {
+  // Matrix is computed in a single request.
+  (void)nb_thread;
+
   const std::string query = this->build_query(locs, _matrix_service);
-  const std::string json_string = this->run_query(query);
 
   // Expected matrix size.
   const std::size_t m_size = locs.size();
 
+  // Matrix values are written straight to matrices while the response
+  // is received, only the rest of the response is stored in
+  // json_result. Unfound routes ('null' values) are tracked to avoid
+  // unexpected behavior.
+  Matrices m(m_size);
   rapidjson::Document json_result;
-  HttpWrapper::parse_response(json_result, json_string);
+  MatricesHandler handler(*this, json_result, m);
+
+  this->run_query(query, [&](ResponseStream& stream) {
+    rapidjson::Reader reader;
+    bool parsed = false;
+    auto generator = [&](rapidjson::Document&) {
+      // Ignore anything after JSON content.
+      parsed = reader.Parse<rapidjson::kParseStopWhenDoneFlag>(stream,
+                                                               handler);
+      return parsed;
+    };
+    json_result.Populate(generator);
+    if (!parsed) {
+      throw RoutingException("Failed to parse routing response.");
+    }
+  });
+
   this->check_response(json_result, locs, _matrix_service);
 
-  if (!json_result.HasMember(_matrix_durations_key.c_str())) {
+  if (!handler.has_durations()) {
     throw RoutingException("Missing " + _matrix_durations_key + ".");
   }
-  assert(json_result[_matrix_durations_key.c_str()].Size() == m_size);
-
-  if (!json_result.HasMember(_matrix_distances_key.c_str())) {
+  if (!handler.has_distances()) {
     throw RoutingException("Missing " + _matrix_distances_key + ".");
   }
-  assert(json_result[_matrix_distances_key.c_str()].Size() == m_size);
-
-  // Build matrices while checking for unfound routes ('null' values)
-  // to avoid unexpected behavior.
-  Matrices m(m_size);
-
-  std::vector<unsigned> nb_unfound_from_loc(m_size, 0);
-  std::vector<unsigned> nb_unfound_to_loc(m_size, 0);
-
-  for (rapidjson::SizeType i = 0; i < m_size; ++i) {
-    const auto& duration_line = json_result[_matrix_durations_key.c_str()][i];
-    const auto& distance_line = json_result[_matrix_distances_key.c_str()][i];
-    assert(duration_line.Size() == m_size);
-    assert(distance_line.Size() == m_size);
-    for (rapidjson::SizeType j = 0; j < m_size; ++j) {
-      if (duration_value_is_null(duration_line[j]) ||
-          distance_value_is_null(distance_line[j])) {
-        // No route found between i and j. Just storing info as we
-        // don't know yet which location is responsible between i
-        // and j.
-        ++nb_unfound_from_loc[i];
-        ++nb_unfound_to_loc[j];
-      } else {
-        m.durations[i][j] = get_duration_value(duration_line[j]);
-        m.distances[i][j] = get_distance_value(distance_line[j]);
-      }
-    }
-  }
 
-  check_unfound(locs, nb_unfound_from_loc, nb_unfound_to_loc);
+  check_unfound(locs,
+                handler.nb_unfound_from_loc(),
+                handler.nb_unfound_to_loc());
 
   return m;
 }
 
+std::string HttpWrapper::matrices_source() const {
+  return _server.host + ":" + _server.port + "/" + _server.path + profile;
+}
+
 void HttpWrapper::update_sparse_matrix(const std::vector<Location>& route_locs,
                                        Matrices& m,
                                        std::mutex& matrix_m,
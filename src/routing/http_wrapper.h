@@ -9,8 +9,12 @@ Copyright (c) 2015-2025, Julien Coupey.
 All rights reserved (see LICENSE).
 
 */
+#include <functional>
+#include <string_view>
+
 #include "../include/rapidjson/include/rapidjson/document.h"
 
+#include "routing/http_response.h"
 #include "routing/wrapper.h"
 #include "structures/typedefs.h"
 #include "utils/helpers.h"
@@ -18,10 +22,16 @@ All rights reserved (see LICENSE).
 namespace vroom::routing {
 
 class HttpWrapper : public Wrapper {
+  friend class MatricesHandler;
+
 private:
-  std::string send_then_receive(const std::string& query) const;
+  void send_then_receive(const std::string& query,
+                         const std::function<void(ResponseStream&)>& parse)
+    const;
 
-  std::string ssl_send_then_receive(const std::string& query) const;
+  void ssl_send_then_receive(
+    const std::string& query,
+    const std::function<void(ResponseStream&)>& parse) const;
 
   static const std::string HTTPS_PORT;
 
@@ -41,6 +51,10 @@ protected:
               std::string route_service,
               std::string routing_args);
 
+  // Parse response body on the fly while it is received.
+  void run_query(const std::string& query,
+                 const std::function<void(ResponseStream&)>& parse) const;
+
   std::string run_query(const std::string& query) const;
 
   static void parse_response(rapidjson::Document& json_result,
@@ -53,35 +67,34 @@ protected:
                               const std::vector<Location>& locs,
                               const std::string& service) const = 0;
 
-  Matrices get_matrices(const std::vector<Location>& locs) const override;
+  Matrices get_matrices(const std::vector<Location>& locs,
+                        unsigned nb_thread) const override;
+
+  std::string matrices_source() const override;
 
   void update_sparse_matrix(const std::vector<Location>& route_locs,
                             Matrices& m,
                             std::mutex& matrix_m,
                             std::string& vehicle_geometry) const override;
 
-  virtual bool
-  duration_value_is_null(const rapidjson::Value& matrix_entry) const {
-    // Same implementation for both OSRM and ORS.
-    return matrix_entry.IsNull();
+  // Matrix entries are plain values by default, overridden when
+  // entries are objects holding values under those keys.
+  virtual std::string_view durations_entry_key() const {
+    return {};
   }
 
-  virtual bool
-  distance_value_is_null(const rapidjson::Value& matrix_entry) const {
-    // Same implementation for both OSRM and ORS.
-    return matrix_entry.IsNull();
+  virtual std::string_view distances_entry_key() const {
+    return {};
   }
 
-  virtual UserDuration
-  get_duration_value(const rapidjson::Value& matrix_entry) const {
+  virtual UserDuration get_duration_value(double value) const {
     // Same implementation for both OSRM and ORS.
-    return utils::round<UserDuration>(matrix_entry.GetDouble());
+    return utils::round<UserDuration>(value);
   }
 
-  virtual UserDistance
-  get_distance_value(const rapidjson::Value& matrix_entry) const {
+  virtual UserDistance get_distance_value(double value) const {
     // Same implementation for both OSRM and ORS.
-    return utils::round<UserDistance>(matrix_entry.GetDouble());
+    return utils::round<UserDistance>(value);
   }
 
   virtual const rapidjson::Value&
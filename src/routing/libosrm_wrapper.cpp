@@ -7,7 +7,10 @@ All rights reserved (see LICENSE).
 
 */
 
+#include <algorithm>
 #include <cstdint>
+#include <numeric>
+#include <thread>
 
 #include "osrm/coordinate.hpp"
 #include "osrm/json_container.hpp"
@@ -21,6 +24,9 @@ All rights reserved (see LICENSE).
 namespace vroom {
 namespace routing {
 
+// Minimum number of source rows per parallel table computation.
+constexpr std::size_t MIN_TABLE_BLOCK_SIZE = 100;
+
 osrm::EngineConfig LibosrmWrapper::get_config(const std::string& profile) {
   osrm::EngineConfig config;
 
@@ -57,7 +63,13 @@ void throw_error(osrm::json::Object& result,
   throw RoutingException("libOSRM: " + code + ": " + message);
 }
 
-Matrices LibosrmWrapper::get_matrices(const std::vector<Location>& locs) const {
+std::string LibosrmWrapper::matrices_source() const {
+  // Dataset name in shared memory.
+  return _config.dataset_name;
+}
+
+Matrices LibosrmWrapper::get_matrices(const std::vector<Location>& locs,
+                                      unsigned nb_thread) const {
   osrm::TableParameters params;
   params.annotations = osrm::engine::api::TableParameters::AnnotationsType::All;
 
@@ -70,55 +82,112 @@ Matrices LibosrmWrapper::get_matrices(const std::vector<Location>& locs) const {
     params.radiuses.emplace_back(DEFAULT_LIBOSRM_SNAPPING_RADIUS);
   }
 
-  osrm::json::Object result;
-  osrm::Status status = _osrm.Table(params, result);
-
-  if (status == osrm::Status::Error) {
-    throw_error(result, locs);
-  }
-
-  const auto& durations =
-    std::get<osrm::json::Array>(result.values["durations"]);
-  const auto& distances =
-    std::get<osrm::json::Array>(result.values["distances"]);
-
   // Expected matrix size.
-  std::size_t m_size = locs.size();
-  assert(durations.values.size() == m_size);
-  assert(distances.values.size() == m_size);
+  const std::size_t m_size = locs.size();
+
+  // Split table computation across threads based on blocks of
+  // consecutive source rows, all locations being used as
+  // destinations.
+  const auto nb_blocks = static_cast<unsigned>(
+    std::max<std::size_t>(1,
+                          std::min<std::size_t>(m_size / MIN_TABLE_BLOCK_SIZE,
+                                                nb_thread)));
 
   // Build matrix while checking for unfound routes to avoid
   // unexpected behavior (OSRM raises 'null').
   Matrices m(m_size);
 
   std::vector<unsigned> nb_unfound_from_loc(m_size, 0);
-  std::vector<unsigned> nb_unfound_to_loc(m_size, 0);
+  std::vector<std::vector<unsigned>>
+    blocks_nb_unfound_to_loc(nb_blocks, std::vector<unsigned>(m_size, 0));
+
+  std::exception_ptr ep = nullptr;
+  std::mutex ep_m;
+
+  auto run_on_block = [&](unsigned block_rank) {
+    try {
+      const std::size_t begin = block_rank * m_size / nb_blocks;
+      const std::size_t end = (block_rank + 1) * m_size / nb_blocks;
+
+      osrm::TableParameters block_params(params);
+      if (nb_blocks > 1) {
+        block_params.sources.resize(end - begin);
+        std::iota(block_params.sources.begin(),
+                  block_params.sources.end(),
+                  begin);
+      }
 
-  std::string reason;
-  for (std::size_t i = 0; i < m_size; ++i) {
-    const auto& duration_line =
-      std::get<osrm::json::Array>(durations.values.at(i));
-    const auto& distance_line =
-      std::get<osrm::json::Array>(distances.values.at(i));
-    assert(duration_line.values.size() == m_size);
-    assert(distance_line.values.size() == m_size);
+      osrm::json::Object result;
+      const osrm::Status status = _osrm.Table(block_params, result);
 
-    for (std::size_t j = 0; j < m_size; ++j) {
-      const auto& duration_el = duration_line.values.at(j);
-      const auto& distance_el = distance_line.values.at(j);
-      if (std::holds_alternative<osrm::json::Null>(duration_el) ||
-          std::holds_alternative<osrm::json::Null>(distance_el)) {
-        // No route found between i and j. Just storing info as we
-        // don't know yet which location is responsible between i
-        // and j.
-        ++nb_unfound_from_loc[i];
-        ++nb_unfound_to_loc[j];
-      } else {
-        m.durations[i][j] = utils::round<UserDuration>(
-          std::get<osrm::json::Number>(duration_el).value);
-        m.distances[i][j] = utils::round<UserDistance>(
-          std::get<osrm::json::Number>(distance_el).value);
+      if (status == osrm::Status::Error) {
+        throw_error(result, locs);
       }
+
+      const auto& durations =
+        std::get<osrm::json::Array>(result.values["durations"]);
+      const auto& distances =
+        std::get<osrm::json::Array>(result.values["distances"]);
+      assert(durations.values.size() == end - begin);
+      assert(distances.values.size() == end - begin);
+
+      auto& nb_unfound_to_loc = blocks_nb_unfound_to_loc[block_rank];
+
+      for (std::size_t i = begin; i < end; ++i) {
+        const auto& duration_line =
+          std::get<osrm::json::Array>(durations.values.at(i - begin));
+        const auto& distance_line =
+          std::get<osrm::json::Array>(distances.values.at(i - begin));
+        assert(duration_line.values.size() == m_size);
+        assert(distance_line.values.size() == m_size);
+
+        for (std::size_t j = 0; j < m_size; ++j) {
+          const auto& duration_el = duration_line.values.at(j);
+          const auto& distance_el = distance_line.values.at(j);
+          if (std::holds_alternative<osrm::json::Null>(duration_el) ||
+              std::holds_alternative<osrm::json::Null>(distance_el)) {
+            // No route found between i and j. Just storing info as we
+            // don't know yet which location is responsible between i
+            // and j.
+            ++nb_unfound_from_loc[i];
+            ++nb_unfound_to_loc[j];
+          } else {
+            m.durations[i][j] = utils::round<UserDuration>(
+              std::get<osrm::json::Number>(duration_el).value);
+            m.distances[i][j] = utils::round<UserDistance>(
+              std::get<osrm::json::Number>(distance_el).value);
+          }
+        }
+      }
+    } catch (...) {
+      const std::scoped_lock<std::mutex> lock(ep_m);
+      ep = std::current_exception();
+    }
+  };
+
+  if (nb_blocks == 1) {
+    run_on_block(0);
+  } else {
+    std::vector<std::jthread> table_threads;
+    table_threads.reserve(nb_blocks);
+
+    for (unsigned block_rank = 0; block_rank < nb_blocks; ++block_rank) {
+      table_threads.emplace_back(run_on_block, block_rank);
+    }
+
+    for (auto& t : table_threads) {
+      t.join();
+    }
+  }
+
+  if (ep != nullptr) {
+    std::rethrow_exception(ep);
+  }
+
+  std::vector<unsigned>& nb_unfound_to_loc = blocks_nb_unfound_to_loc[0];
+  for (unsigned block_rank = 1; block_rank < nb_blocks; ++block_rank) {
+    for (std::size_t j = 0; j < m_size; ++j) {
+      nb_unfound_to_loc[j] += blocks_nb_unfound_to_loc[block_rank][j];
     }
   }
 
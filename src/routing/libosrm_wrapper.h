@@ -32,7 +32,10 @@ private:
 public:
   explicit LibosrmWrapper(const std::string& profile);
 
-  Matrices get_matrices(const std::vector<Location>& locs) const override;
+  Matrices get_matrices(const std::vector<Location>& locs,
+                        unsigned nb_thread) const override;
+
+  std::string matrices_source() const override;
 
   void update_sparse_matrix(const std::vector<Location>& route_locs,
                             Matrices& m,
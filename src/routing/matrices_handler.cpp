@@ -0,0 +1,285 @@
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include "routing/matrices_handler.h"
+#include "routing/http_wrapper.h"
+
+namespace vroom::routing {
+
+MatricesHandler::MatricesHandler(const HttpWrapper& wrapper,
+                                 rapidjson::Document& document,
+                                 Matrices& matrices)
+  : _wrapper(wrapper),
+    _document(document),
+    _matrices(matrices),
+    _size(matrices.durations.size()),
+    _durations_entry_key(wrapper.durations_entry_key()),
+    _distances_entry_key(wrapper.distances_entry_key()),
+    _nb_unfound_from_loc(_size, 0),
+    _nb_unfound_to_loc(_size, 0) {
+  assert(_matrices.distances.size() == _size);
+}
+
+bool MatricesHandler::matrix_value(TARGET target, const double* value) {
+  if (value == nullptr) {
+    // No route found between _row and _col. Just storing info as we
+    // don't know yet which location is responsible.
+    if (_unfound.empty()) {
+      _unfound.resize(_size * _size, false);
+    }
+    if (const auto rank = _row * _size + _col; !_unfound[rank]) {
+      _unfound[rank] = true;
+      ++_nb_unfound_from_loc[_row];
+      ++_nb_unfound_to_loc[_col];
+    }
+    return true;
+  }
+
+  if (target == TARGET::DURATION || target == TARGET::BOTH) {
+    _matrices.durations[_row][_col] = _wrapper.get_duration_value(*value);
+  }
+  if (target == TARGET::DISTANCE || target == TARGET::BOTH) {
+    _matrices.distances[_row][_col] = _wrapper.get_distance_value(*value);
+  }
+  return true;
+}
+
+bool MatricesHandler::value(const double* value) {
+  assert(_next_matrix != TARGET::NONE || in_matrix());
+
+  if (_next_matrix != TARGET::NONE) {
+    // Matrix key is not followed by an array.
+    return false;
+  }
+
+  switch (_depth) {
+  case 3:
+    // Plain value in a matrix line.
+    if (_col == _size || !_durations_entry_key.empty()) {
+      return false;
+    }
+    matrix_value(_matrix, value);
+    ++_col;
+    return true;
+  case 4:
+    // Value in a matrix entry object.
+    if (_entry_value != TARGET::NONE) {
+      matrix_value(_entry_value, value);
+      _entry_value = TARGET::NONE;
+    }
+    return true;
+  default:
+    // Deeper values are ignored, values directly in matrix array are
+    // invalid.
+    return _depth > 4;
+  }
+}
+
+bool MatricesHandler::Null() {
+  if (_next_matrix != TARGET::NONE || in_matrix()) {
+    return value(nullptr);
+  }
+  return _document.Null();
+}
+
+bool MatricesHandler::Bool(bool b) {
+  if (_next_matrix != TARGET::NONE || in_matrix()) {
+    return _next_matrix == TARGET::NONE && _depth > 3;
+  }
+  return _document.Bool(b);
+}
+
+bool MatricesHandler::Int(int i) {
+  if (_next_matrix != TARGET::NONE || in_matrix()) {
+    const auto d = static_cast<double>(i);
+    return value(&d);
+  }
+  return _document.Int(i);
+}
+
+bool MatricesHandler::Uint(unsigned u) {
+  if (_next_matrix != TARGET::NONE || in_matrix()) {
+    const auto d = static_cast<double>(u);
+    return value(&d);
+  }
+  return _document.Uint(u);
+}
+
+bool MatricesHandler::Int64(int64_t i) {
+  if (_next_matrix != TARGET::NONE || in_matrix()) {
+    const auto d = static_cast<double>(i);
+    return value(&d);
+  }
+  return _document.Int64(i);
+}
+
+bool MatricesHandler::Uint64(uint64_t u) {
+  if (_next_matrix != TARGET::NONE || in_matrix()) {
+    const auto d = static_cast<double>(u);
+    return value(&d);
+  }
+  return _document.Uint64(u);
+}
+
+bool MatricesHandler::Double(double d) {
+  if (_next_matrix != TARGET::NONE || in_matrix()) {
+    return value(&d);
+  }
+  return _document.Double(d);
+}
+
+bool MatricesHandler::RawNumber(const char* str,
+                                rapidjson::SizeType length,
+                                bool copy) {
+  if (_next_matrix != TARGET::NONE || in_matrix()) {
+    // Not expected without kParseNumbersAsStringsFlag.
+    return false;
+  }
+  return _document.RawNumber(str, length, copy);
+}
+
+bool MatricesHandler::String(const char* str,
+                             rapidjson::SizeType length,
+                             bool copy) {
+  if (_next_matrix != TARGET::NONE || in_matrix()) {
+    // Only allowed for ignored members of matrix entry objects.
+    _entry_value = TARGET::NONE;
+    return _next_matrix == TARGET::NONE && _depth > 3;
+  }
+  return _document.String(str, length, copy);
+}
+
+bool MatricesHandler::StartObject() {
+  if (_next_matrix != TARGET::NONE) {
+    return false;
+  }
+
+  ++_depth;
+  if (in_matrix()) {
+    if (_depth == 4) {
+      // Matrix entry object.
+      if (_col == _size || _durations_entry_key.empty()) {
+        return false;
+      }
+      _entry_value = TARGET::NONE;
+    }
+    return _depth > 3;
+  }
+
+  return _document.StartObject();
+}
+
+bool MatricesHandler::Key(const char* str,
+                          rapidjson::SizeType length,
+                          bool copy) {
+  const std::string_view key(str, length);
+
+  if (in_matrix()) {
+    if (_depth == 4) {
+      const bool is_duration = (_matrix == TARGET::DURATION ||
+                                _matrix == TARGET::BOTH) &&
+                               key == _durations_entry_key;
+      const bool is_distance = (_matrix == TARGET::DISTANCE ||
+                                _matrix == TARGET::BOTH) &&
+                               key == _distances_entry_key;
+      _entry_value = is_duration   ? TARGET::DURATION
+                     : is_distance ? TARGET::DISTANCE
+                                   : TARGET::NONE;
+    }
+    return true;
+  }
+
+  if (_depth == 1) {
+    const bool is_durations = (key == _wrapper._matrix_durations_key);
+    const bool is_distances = (key == _wrapper._matrix_distances_key);
+    if (is_durations || is_distances) {
+      _next_matrix = (is_durations && is_distances) ? TARGET::BOTH
+                     : is_durations                 ? TARGET::DURATION
+                                                    : TARGET::DISTANCE;
+      ++_skipped_members;
+      return true;
+    }
+  }
+
+  return _document.Key(str, length, copy);
+}
+
+bool MatricesHandler::EndObject(rapidjson::SizeType member_count) {
+  if (in_matrix()) {
+    if (_depth == 4) {
+      ++_col;
+      _entry_value = TARGET::NONE;
+    }
+    --_depth;
+    return true;
+  }
+
+  if (_depth == 1) {
+    // Closing root object.
+    member_count -= _skipped_members;
+  }
+  --_depth;
+  return _document.EndObject(member_count);
+}
+
+bool MatricesHandler::StartArray() {
+  if (_next_matrix != TARGET::NONE) {
+    assert(_depth == 1);
+    _matrix = _next_matrix;
+    _next_matrix = TARGET::NONE;
+    _row = 0;
+    ++_depth;
+    return true;
+  }
+
+  ++_depth;
+  if (in_matrix()) {
+    if (_depth == 3) {
+      // Matrix line.
+      if (_row == _size) {
+        return false;
+      }
+      _col = 0;
+      return true;
+    }
+    return _depth > 4;
+  }
+
+  return _document.StartArray();
+}
+
+bool MatricesHandler::EndArray(rapidjson::SizeType element_count) {
+  if (in_matrix()) {
+    if (_depth == 3) {
+      // End of matrix line.
+      if (_col != _size) {
+        return false;
+      }
+      ++_row;
+    }
+    if (_depth == 2) {
+      // End of matrix.
+      if (_row != _size) {
+        return false;
+      }
+      _has_durations = _has_durations || _matrix == TARGET::DURATION ||
+                       _matrix == TARGET::BOTH;
+      _has_distances = _has_distances || _matrix == TARGET::DISTANCE ||
+                       _matrix == TARGET::BOTH;
+      _matrix = TARGET::NONE;
+    }
+    --_depth;
+    return true;
+  }
+
+  --_depth;
+  return _document.EndArray(element_count);
+}
+
+} // namespace vroom::routing
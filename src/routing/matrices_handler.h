@@ -0,0 +1,114 @@
+#ifndef MATRICES_HANDLER_H
+#define MATRICES_HANDLER_H
+
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include <cassert>
+#include <string_view>
+#include <vector>
+
+#include "../include/rapidjson/include/rapidjson/document.h"
+
+#include "structures/generic/matrix.h"
+#include "structures/vroom/matrices.h"
+
+namespace vroom::routing {
+
+class HttpWrapper;
+
+// SAX handler for matrix responses: values under the durations and
+// distances keys are written straight to Matrices while the rest of
+// the response is forwarded to a Document, e.g. to check for errors.
+class MatricesHandler {
+private:
+  enum class TARGET : std::uint8_t { NONE, DURATION, DISTANCE, BOTH };
+
+  const HttpWrapper& _wrapper;
+  rapidjson::Document& _document;
+  Matrices& _matrices;
+  const std::size_t _size;
+
+  // Keys for values in matrix entry objects, empty for plain values.
+  const std::string_view _durations_entry_key;
+  const std::string_view _distances_entry_key;
+
+  // Number of currently open objects and arrays.
+  unsigned _depth{0};
+  // Members of the root object not forwarded to _document.
+  unsigned _skipped_members{0};
+
+  // Set upon reading a matrix key in root object.
+  TARGET _next_matrix{TARGET::NONE};
+  // Set while inside a matrix array.
+  TARGET _matrix{TARGET::NONE};
+  // Set upon reading a value key inside a matrix entry object.
+  TARGET _entry_value{TARGET::NONE};
+
+  std::size_t _row{0};
+  std::size_t _col{0};
+
+  bool _has_durations{false};
+  bool _has_distances{false};
+
+  std::vector<unsigned> _nb_unfound_from_loc;
+  std::vector<unsigned> _nb_unfound_to_loc;
+  // Only allocated upon first missing value, used to count each
+  // unfound route once.
+  std::vector<bool> _unfound;
+
+  bool in_matrix() const {
+    return _matrix != TARGET::NONE;
+  }
+
+  bool matrix_value(TARGET target, const double* value);
+
+  bool value(const double* value);
+
+public:
+  MatricesHandler(const HttpWrapper& wrapper,
+                  rapidjson::Document& document,
+                  Matrices& matrices);
+
+  bool has_durations() const {
+    return _has_durations;
+  }
+
+  bool has_distances() const {
+    return _has_distances;
+  }
+
+  const std::vector<unsigned>& nb_unfound_from_loc() const {
+    return _nb_unfound_from_loc;
+  }
+
+  const std::vector<unsigned>& nb_unfound_to_loc() const {
+    return _nb_unfound_to_loc;
+  }
+
+  // rapidjson Handler concept.
+  bool Null();
+  bool Bool(bool b);
+  bool Int(int i);
+  bool Uint(unsigned u);
+  bool Int64(int64_t i);
+  bool Uint64(uint64_t u);
+  bool Double(double d);
+  bool RawNumber(const char* str, rapidjson::SizeType length, bool copy);
+  bool String(const char* str, rapidjson::SizeType length, bool copy);
+  bool StartObject();
+  bool Key(const char* str, rapidjson::SizeType length, bool copy);
+  bool EndObject(rapidjson::SizeType member_count);
+  bool StartArray();
+  bool EndArray(rapidjson::SizeType element_count);
+};
+
+} // namespace vroom::routing
+
+#endif
@@ -49,6 +49,7 @@ std::string OrsWrapper::build_query(const std::vector<Location>& locations,
 
   query += " HTTP/1.0\r\n";
   query += "Accept: */*\r\n";
+  query += "Accept-Encoding: gzip, deflate\r\n";
   query += "Content-Type: application/json\r\n";
   query += std::format("Content-Length: {}\r\n", body.size());
   query += "Host: " + _server.host + ":" + _server.port + "\r\n";
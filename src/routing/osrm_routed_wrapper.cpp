@@ -23,6 +23,12 @@ OsrmRoutedWrapper::OsrmRoutedWrapper(const std::string& profile,
                 "straight=false") {
 }
 
+std::string OsrmRoutedWrapper::matrices_source() const {
+  // An osrm-routed instance serves a single dataset, whatever the
+  // profile name used in queries.
+  return _server.host + ":" + _server.port + "/" + _server.path;
+}
+
 std::string
 OsrmRoutedWrapper::build_query(const std::vector<Location>& locations,
                                const std::string& service) const {
@@ -57,6 +63,7 @@ OsrmRoutedWrapper::build_query(const std::vector<Location>& locations,
   query += " HTTP/1.1\r\n";
   query += "Host: " + _server.host + "\r\n";
   query += "Accept: */*\r\n";
+  query += "Accept-Encoding: gzip, deflate\r\n";
   query += "Connection: close\r\n\r\n";
 
   return query;
@@ -28,6 +28,8 @@ private:
 
 public:
   OsrmRoutedWrapper(const std::string& profile, const Server& server);
+
+  std::string matrices_source() const override;
 };
 
 } // namespace vroom::routing
@@ -50,6 +50,7 @@ std::string ValhallaWrapper::get_matrix_query(
   query += " HTTP/1.1\r\n";
   query += "Host: " + _server.host + "\r\n";
   query += "Accept: */*\r\n";
+  query += "Accept-Encoding: gzip, deflate\r\n";
   query += "Connection: Close\r\n\r\n";
 
   return query;
@@ -75,6 +76,7 @@ ValhallaWrapper::get_route_query(const std::vector<Location>& locations) const {
   query += " HTTP/1.1\r\n";
   query += "Host: " + _server.host + "\r\n";
   query += "Accept: */*\r\n";
+  query += "Accept-Encoding: gzip, deflate\r\n";
   query += "Connection: Close\r\n\r\n";
 
   return query;
@@ -123,29 +125,16 @@ void ValhallaWrapper::check_response(const rapidjson::Document& json_result,
   }
 }
 
-bool ValhallaWrapper::duration_value_is_null(
-  const rapidjson::Value& matrix_entry) const {
-  assert(matrix_entry.HasMember("time"));
-  return matrix_entry["time"].IsNull();
+std::string_view ValhallaWrapper::durations_entry_key() const {
+  return "time";
 }
 
-bool ValhallaWrapper::distance_value_is_null(
-  const rapidjson::Value& matrix_entry) const {
-  assert(matrix_entry.HasMember("distance"));
-  return matrix_entry["distance"].IsNull();
+std::string_view ValhallaWrapper::distances_entry_key() const {
+  return "distance";
 }
 
-UserDuration ValhallaWrapper::get_duration_value(
-  const rapidjson::Value& matrix_entry) const {
-  assert(matrix_entry["time"].IsUint());
-  return matrix_entry["time"].GetUint();
-}
-
-UserDistance ValhallaWrapper::get_distance_value(
-  const rapidjson::Value& matrix_entry) const {
-  assert(matrix_entry["distance"].IsDouble());
-  return utils::round<UserDistance>(km_to_m *
-                                    matrix_entry["distance"].GetDouble());
+UserDistance ValhallaWrapper::get_distance_value(double value) const {
+  return utils::round<UserDistance>(km_to_m * value);
 }
 
 const rapidjson::Value&
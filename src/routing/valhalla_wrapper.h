@@ -27,17 +27,11 @@ private:
                       const std::vector<Location>& locs,
                       const std::string& service) const override;
 
-  bool
-  duration_value_is_null(const rapidjson::Value& matrix_entry) const override;
+  std::string_view durations_entry_key() const override;
 
-  bool
-  distance_value_is_null(const rapidjson::Value& matrix_entry) const override;
+  std::string_view distances_entry_key() const override;
 
-  UserDuration
-  get_duration_value(const rapidjson::Value& matrix_entry) const override;
-
-  UserDistance
-  get_distance_value(const rapidjson::Value& matrix_entry) const override;
+  UserDistance get_distance_value(double value) const override;
 
   const rapidjson::Value&
   get_legs(const rapidjson::Value& result) const override;
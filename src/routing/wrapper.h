@@ -28,7 +28,14 @@ class Wrapper {
 public:
   std::string profile;
 
-  virtual Matrices get_matrices(const std::vector<Location>& locs) const = 0;
+  // Wrappers may split computation across up to nb_thread threads.
+  virtual Matrices get_matrices(const std::vector<Location>& locs,
+                                unsigned nb_thread) const = 0;
+
+  // Identifies the data used to answer matrix requests: wrappers
+  // with the same source return identical matrices for a given set of
+  // locations.
+  virtual std::string matrices_source() const = 0;
 
   Matrices
   get_sparse_matrices(const std::vector<Location>& locs,
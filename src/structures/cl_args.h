@@ -10,6 +10,7 @@ All rights reserved (see LICENSE).
 
 */
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -23,18 +24,24 @@ using Servers =
 
 struct CLArgs {
   // Listing command-line options.
-  Servers servers;         // -a and -p
-  bool check;              // -c
-  bool apply_TSPFix;       // -f
-  bool geometry;           // -g
-  std::string input_file;  // -i
-  Timeout timeout;         // -l
-  std::string output_file; // -o
-  ROUTER router;           // -r
-  std::string input;       // cl arg
-  unsigned nb_threads;     // -t
-  unsigned nb_searches;    // derived from -x
-  unsigned depth;          // derived from -x
+  Servers servers;                       // -a and -p
+  bool check;                            // -c
+  bool apply_TSPFix;                     // -f
+  bool geometry;                         // -g
+  std::string input_file;                // -i
+  Timeout timeout;                       // -l
+  std::string output_file;               // -o
+  ROUTER router;                         // -r
+  std::string input;                     // cl arg
+  unsigned nb_threads;                   // -t
+  unsigned nb_searches;                  // derived from -x
+  unsigned depth;                        // derived from -x
+  bool auto_exploration;                 // -x auto
+  bool aggregate_jobs;                   // --aggregate
+  std::optional<unsigned> max_moves;     // --max-moves
+  std::optional<unsigned> nb_neighbours; // --neighbours
+  bool adaptive_operators;               // --adaptive-operators
+  bool ruin_and_recreate;                // --ruin-recreate
 
   void set_exploration_level(unsigned exploration_level);
 };
@@ -0,0 +1,106 @@
+#ifndef BIT_MATRIX_H
+#define BIT_MATRIX_H
+
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace vroom {
+
+// Boolean matrix with rows packed into 64-bit words. Rows start on a
+// new word so distinct rows can be written concurrently.
+class BitMatrix {
+  using Word = std::uint64_t;
+  static constexpr std::size_t WORD_SIZE = 64;
+
+  std::size_t _nb_rows;
+  std::size_t _nb_cols;
+  std::size_t _nb_words_per_row;
+  std::vector<Word> _words;
+
+  Word& word(std::size_t i, std::size_t j) {
+    return _words[i * _nb_words_per_row + j / WORD_SIZE];
+  }
+
+  const Word& word(std::size_t i, std::size_t j) const {
+    return _words[i * _nb_words_per_row + j / WORD_SIZE];
+  }
+
+  static Word mask(std::size_t j) {
+    return Word{1} << (j % WORD_SIZE);
+  }
+
+public:
+  BitMatrix() : BitMatrix(0, 0, false) {
+  }
+
+  BitMatrix(std::size_t nb_rows, std::size_t nb_cols, bool value)
+    : _nb_rows(nb_rows),
+      _nb_cols(nb_cols),
+      _nb_words_per_row((nb_cols + WORD_SIZE - 1) / WORD_SIZE),
+      _words(nb_rows * _nb_words_per_row, value ? ~Word{0} : Word{0}) {
+    if (value && nb_cols % WORD_SIZE != 0) {
+      // Keep padding bits unset for row intersections.
+      const Word last_mask = (Word{1} << (nb_cols % WORD_SIZE)) - 1;
+      for (std::size_t i = 0; i < nb_rows; ++i) {
+        _words[(i + 1) * _nb_words_per_row - 1] = last_mask;
+      }
+    }
+  }
+
+  std::size_t nb_rows() const {
+    return _nb_rows;
+  }
+
+  std::size_t nb_cols() const {
+    return _nb_cols;
+  }
+
+  bool operator()(std::size_t i, std::size_t j) const {
+    assert(i < _nb_rows && j < _nb_cols);
+    return (word(i, j) & mask(j)) != 0;
+  }
+
+  void set(std::size_t i, std::size_t j, bool value) {
+    assert(i < _nb_rows && j < _nb_cols);
+    if (value) {
+      word(i, j) |= mask(j);
+    } else {
+      word(i, j) &= ~mask(j);
+    }
+  }
+
+  void copy_row(std::size_t from, std::size_t to) {
+    assert(from < _nb_rows && to < _nb_rows);
+    std::copy_n(_words.begin() + from * _nb_words_per_row,
+                _nb_words_per_row,
+                _words.begin() + to * _nb_words_per_row);
+  }
+
+  // Returns true iff rows i1 and i2 have a common set bit.
+  bool rows_intersect(std::size_t i1, std::size_t i2) const {
+    assert(i1 < _nb_rows && i2 < _nb_rows);
+    const Word* const row_1 = _words.data() + i1 * _nb_words_per_row;
+    const Word* const row_2 = _words.data() + i2 * _nb_words_per_row;
+    for (std::size_t w = 0; w < _nb_words_per_row; ++w) {
+      if ((row_1[w] & row_2[w]) != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+} // namespace vroom
+
+#endif
@@ -10,6 +10,7 @@ All rights reserved (see LICENSE).
 
 */
 
+#include <cassert>
 #include <vector>
 
 #include "structures/typedefs.h"
@@ -19,19 +20,28 @@ namespace vroom {
 template <class T> class Matrix {
 
   std::size_t n;
+  // Row length, equal to n for square matrices.
+  std::size_t m;
   std::vector<T> data;
 
 public:
-  Matrix() : Matrix(0) {
+  Matrix() : Matrix(0, 0, T()) {
   }
 
   explicit Matrix(std::size_t n) : Matrix(n, 0) {
   }
 
-  Matrix(std::size_t n, T value) : n(n), data(n * n, value) {
+  Matrix(std::size_t n, T value) : Matrix(n, n, value) {
+  }
+
+  // Rectangular matrix with n rows of size m, only meant for indexing
+  // as matrix[i][j].
+  Matrix(std::size_t n, std::size_t m, T value)
+    : n(n), m(m), data(n * m, value) {
   }
 
   Matrix<T> get_sub_matrix(const std::vector<Index>& indices) const {
+    assert(n == m);
     Matrix<T> sub_matrix(indices.size());
     for (std::size_t i = 0; i < indices.size(); ++i) {
       for (std::size_t j = 0; j < indices.size(); ++j) {
@@ -41,11 +51,26 @@ public:
     return sub_matrix;
   }
 
+  // Whether values for all pairs of given indices are identical in
+  // both directions.
+  bool is_symmetric(const std::vector<Index>& indices) const {
+    assert(n == m);
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+      for (std::size_t j = i + 1; j < indices.size(); ++j) {
+        if ((*this)[indices[i]][indices[j]] !=
+            (*this)[indices[j]][indices[i]]) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
   T* operator[](std::size_t i) {
-    return data.data() + (i * n);
+    return data.data() + (i * m);
   }
   const T* operator[](std::size_t i) const {
-    return data.data() + (i * n);
+    return data.data() + (i * m);
   }
 
   std::size_t size() const {
@@ -110,6 +110,15 @@ struct Server {
   }
 };
 
+// Number of searches, local search depth and number of threads used
+// to evaluate moves within each search. Available threads not used
+// within searches run searches concurrently.
+struct Exploration {
+  unsigned nb_searches;
+  unsigned depth;
+  unsigned ls_nb_threads;
+};
+
 // 'Single' job is a regular one-stop job without precedence
 // constraints.
 enum class JOB_TYPE : std::uint8_t { SINGLE, PICKUP, DELIVERY };
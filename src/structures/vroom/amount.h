@@ -10,7 +10,9 @@ All rights reserved (see LICENSE).
 
 */
 
+#include <array>
 #include <cassert>
+#include <utility>
 #include <vector>
 
 #include "structures/typedefs.h"
@@ -54,13 +56,12 @@ bool operator<(const AmountExpression<E1>& lhs,
 template <typename E1, typename E2>
 bool operator<=(const AmountExpression<E1>& lhs,
                 const AmountExpression<E2>& rhs) {
+  // No early exit so that the loop can be vectorized, amounts have
+  // few dimensions anyway.
   bool is_inf = true;
   assert(lhs.size() == rhs.size());
   for (std::size_t i = 0; i < lhs.size(); ++i) {
-    if (lhs[i] > rhs[i]) {
-      is_inf = false;
-      break;
-    }
+    is_inf &= (lhs[i] <= rhs[i]);
   }
 
   return is_inf;
@@ -72,74 +73,133 @@ bool operator==(const AmountExpression<E1>& lhs,
   bool is_equal = true;
   assert(lhs.size() == rhs.size());
   for (std::size_t i = 0; i < lhs.size(); ++i) {
-    if (lhs[i] != rhs[i]) {
-      is_equal = false;
-      break;
-    }
+    is_equal &= (lhs[i] == rhs[i]);
   }
 
   return is_equal;
 }
 
 class Amount : public AmountExpression<Amount> {
+  // Amounts with up to INLINE_SIZE dimensions, which covers most use
+  // cases, are stored inline so that copies and temporaries do not
+  // require heap allocations. Larger amounts only use heap_elems.
+  static constexpr std::size_t INLINE_SIZE = 4;
 
-  std::vector<Capacity> elems;
+  std::size_t nb_elems{0};
+  std::array<Capacity, INLINE_SIZE> inline_elems{};
+  std::vector<Capacity> heap_elems;
+
+  bool is_inline() const {
+    return nb_elems <= INLINE_SIZE;
+  }
+
+  const Capacity* data() const {
+    return is_inline() ? inline_elems.data() : heap_elems.data();
+  }
+
+  Capacity* data() {
+    return is_inline() ? inline_elems.data() : heap_elems.data();
+  }
 
 public:
   Amount() = default;
 
-  explicit Amount(std::size_t size) : elems(size, 0){};
+  Amount(const Amount&) = default;
+  Amount& operator=(const Amount&) = default;
+
+  // Moved-from amounts are left empty, so that nb_elems always
+  // matches the storage in use.
+  Amount(Amount&& other) noexcept
+    : nb_elems(other.nb_elems),
+      inline_elems(other.inline_elems),
+      heap_elems(std::move(other.heap_elems)) {
+    other.nb_elems = 0;
+    other.heap_elems.clear();
+  }
+
+  Amount& operator=(Amount&& other) noexcept {
+    if (this != &other) {
+      nb_elems = other.nb_elems;
+      inline_elems = other.inline_elems;
+      heap_elems = std::move(other.heap_elems);
+      other.nb_elems = 0;
+      other.heap_elems.clear();
+    }
+    return *this;
+  }
 
-  template <typename E> Amount(const AmountExpression<E>& u) {
-    elems.resize(u.size());
-    for (std::size_t i = 0; i < u.size(); ++i) {
+  explicit Amount(std::size_t size) : nb_elems(size) {
+    if (!is_inline()) {
+      heap_elems.resize(size, 0);
+    }
+  }
+
+  template <typename E>
+  Amount(const AmountExpression<E>& u) : Amount(u.size()) {
+    Capacity* elems = data();
+    for (std::size_t i = 0; i < nb_elems; ++i) {
       elems[i] = u[i];
     }
   }
 
   void push_back(Capacity c) {
-    elems.push_back(c);
+    if (nb_elems < INLINE_SIZE) {
+      inline_elems[nb_elems] = c;
+    } else {
+      if (nb_elems == INLINE_SIZE) {
+        heap_elems.assign(inline_elems.begin(), inline_elems.end());
+      }
+      heap_elems.push_back(c);
+    }
+    ++nb_elems;
   }
 
   Capacity operator[](std::size_t i) const {
-    return elems[i];
+    assert(i < nb_elems);
+    return data()[i];
   }
 
   Capacity& operator[](std::size_t i) {
-    return elems[i];
+    assert(i < nb_elems);
+    return data()[i];
   }
 
   std::size_t size() const {
-    return elems.size();
+    return nb_elems;
   }
 
   Amount& operator+=(const Amount& rhs) {
     assert(this->size() == rhs.size());
-    for (std::size_t i = 0; i < this->size(); ++i) {
-      (*this)[i] += rhs[i];
+    Capacity* elems = data();
+    const Capacity* rhs_elems = rhs.data();
+    for (std::size_t i = 0; i < nb_elems; ++i) {
+      elems[i] += rhs_elems[i];
     }
     return *this;
   }
 
   Amount& operator-=(const Amount& rhs) {
     assert(this->size() == rhs.size());
-    for (std::size_t i = 0; i < this->size(); ++i) {
-      (*this)[i] -= rhs[i];
+    Capacity* elems = data();
+    const Capacity* rhs_elems = rhs.data();
+    for (std::size_t i = 0; i < nb_elems; ++i) {
+      elems[i] -= rhs_elems[i];
     }
     return *this;
   }
 
 #if USE_PYTHON_BINDINGS
   Capacity* get_data() {
-    return elems.data();
+    return data();
   };
 #endif
 
   template <class AmountExpression>
   Amount& operator+=(const AmountExpression& rhs) {
     assert(this->size() == rhs.size());
-    for (std::size_t i = 0; i < this->size(); ++i) {
-      (*this)[i] += rhs[i];
+    Capacity* elems = data();
+    for (std::size_t i = 0; i < nb_elems; ++i) {
+      elems[i] += rhs[i];
     }
     return *this;
   }
@@ -147,8 +207,9 @@ public:
   template <class AmountExpression>
   Amount& operator-=(const AmountExpression& rhs) {
     assert(this->size() == rhs.size());
-    for (std::size_t i = 0; i < this->size(); ++i) {
-      (*this)[i] -= rhs[i];
+    Capacity* elems = data();
+    for (std::size_t i = 0; i < nb_elems; ++i) {
+      elems[i] -= rhs[i];
     }
     return *this;
   }
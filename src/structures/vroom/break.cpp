@@ -42,4 +42,10 @@ bool Break::is_valid_for_load(const Amount& load) const {
   return !max_load.has_value() || load <= max_load.value();
 }
 
+bool Break::has_same_constraints(const Break& other) const {
+  return tws == other.tws && service == other.service &&
+         max_load.has_value() == other.max_load.has_value() &&
+         (!max_load.has_value() || max_load.value() == other.max_load.value());
+}
+
 } // namespace vroom
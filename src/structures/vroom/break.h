@@ -35,6 +35,9 @@ struct Break {
   bool is_valid_start(Duration time) const;
 
   bool is_valid_for_load(const Amount& load) const;
+
+  // Same constraints, regardless of id and description.
+  bool has_same_constraints(const Break& other) const;
 };
 
 } // namespace vroom
@@ -40,6 +40,9 @@ private:
 
   bool _cost_based_on_metrics{true};
 
+  // Whether cost(i, j) == cost(j, i) for all locations in use.
+  bool _symmetric_costs{false};
+
 public:
   CostWrapper(double speed_factor, Cost per_hour, Cost per_km);
 
@@ -50,10 +53,26 @@ public:
   void set_costs_matrix(const Matrix<UserCost>* matrix,
                         bool reset_cost_factor = false);
 
+  Duration duration_factor() const {
+    return discrete_duration_factor;
+  }
+
   bool cost_based_on_metrics() const {
     return _cost_based_on_metrics;
   }
 
+  void set_symmetric_costs(bool symmetric_costs) {
+    _symmetric_costs = symmetric_costs;
+  }
+
+  bool has_symmetric_costs() const {
+    return _symmetric_costs;
+  }
+
+  // Same matrices and factors.
+  friend bool operator==(const CostWrapper& lhs,
+                         const CostWrapper& rhs) = default;
+
   bool has_same_variable_costs(const CostWrapper& other) const {
     return (this->discrete_duration_cost_factor ==
             other.discrete_duration_cost_factor) &&
@@ -30,6 +30,105 @@ All rights reserved (see LICENSE).
 
 namespace vroom {
 
+inline std::string get_job_type_str(JOB_TYPE type) {
+  switch (type) {
+  case JOB_TYPE::SINGLE:
+    return "job";
+  case JOB_TYPE::PICKUP:
+    return "pickup";
+  default:
+    return "delivery";
+  }
+}
+
+inline void append_location(std::string& key, const Location& location) {
+  // Indices are only relevant when provided by user, otherwise they
+  // derive from coordinates.
+  utils::append_to_key(key, location.user_index());
+  if (location.user_index()) {
+    utils::append_to_key(key, location.index());
+  }
+  utils::append_to_key(key, location.has_coordinates());
+  if (location.has_coordinates()) {
+    utils::append_to_key(key, location.lon());
+    utils::append_to_key(key, location.lat());
+  }
+}
+
+inline void append_location(std::string& key,
+                            const std::optional<Location>& location) {
+  utils::append_to_key(key, location.has_value());
+  if (location.has_value()) {
+    append_location(key, location.value());
+  }
+}
+
+inline void append_amount(std::string& key, const Amount& amount) {
+  utils::append_to_key(key, amount.size());
+  for (std::size_t i = 0; i < amount.size(); ++i) {
+    utils::append_to_key(key, amount[i]);
+  }
+}
+
+inline void append_tws(std::string& key, const std::vector<TimeWindow>& tws) {
+  utils::append_to_key(key, tws.size());
+  for (const auto& tw : tws) {
+    utils::append_to_key(key, tw.start);
+    utils::append_to_key(key, tw.end);
+  }
+}
+
+// Unordered containers are sorted first so that the key does not
+// depend on insertion order.
+inline void append_skills(std::string& key, const Skills& skills) {
+  std::vector<Skill> sorted_skills(skills.begin(), skills.end());
+  std::ranges::sort(sorted_skills);
+
+  utils::append_to_key(key, sorted_skills.size());
+  for (const auto s : sorted_skills) {
+    utils::append_to_key(key, s);
+  }
+}
+
+inline void append_durations_per_type(std::string& key,
+                                      const TypeToDurationMap& durations) {
+  std::vector<std::pair<std::string_view, Duration>>
+    sorted_durations(durations.begin(), durations.end());
+  std::ranges::sort(sorted_durations);
+
+  utils::append_to_key(key, sorted_durations.size());
+  for (const auto& [type, duration] : sorted_durations) {
+    utils::append_to_key(key, type);
+    utils::append_to_key(key, duration);
+  }
+}
+
+template <typename T, typename F>
+inline void append_matrices(
+  std::string& key,
+  const std::unordered_map<std::string, Matrix<T>, StringHash, std::equal_to<>>&
+    matrices,
+  const F& is_custom) {
+  std::vector<std::string_view> profiles;
+  for (const auto& [profile, matrix] : matrices) {
+    if (is_custom(profile)) {
+      profiles.push_back(profile);
+    }
+  }
+  std::ranges::sort(profiles);
+
+  utils::append_to_key(key, profiles.size());
+  for (const auto profile : profiles) {
+    const auto& matrix = matrices.find(profile)->second;
+    utils::append_to_key(key, profile);
+    utils::append_to_key(key, matrix.size());
+    for (std::size_t i = 0; i < matrix.size(); ++i) {
+      key.append(reinterpret_cast<const char*>(matrix[i]),
+                 matrix.size() * sizeof(T));
+    }
+  }
+}
+
 Input::Input(io::Servers servers, ROUTER router, bool apply_TSPFix)
   : _apply_TSPFix(apply_TSPFix), _servers(std::move(servers)), _router(router) {
 }
@@ -38,6 +137,28 @@ void Input::set_geometry(bool geometry) {
   _geometry = geometry;
 }
 
+void Input::set_jobs_aggregation(bool aggregate) {
+  _prepared = false;
+  _aggregate_jobs = aggregate;
+}
+
+void Input::set_max_moves(const std::optional<unsigned>& max_moves) {
+  _max_moves = max_moves;
+}
+
+void Input::set_granularity(const std::optional<unsigned>& nb_neighbours) {
+  _prepared = false;
+  _nb_neighbours = nb_neighbours;
+}
+
+void Input::set_adaptive_operators(bool adaptive) {
+  _adaptive_operators = adaptive;
+}
+
+void Input::set_ruin_and_recreate(bool ruin_and_recreate) {
+  _ruin_and_recreate = ruin_and_recreate;
+}
+
 void Input::add_routing_wrapper(const std::string& profile) {
 #if !USE_ROUTING
   throw RoutingException("VROOM compiled without routing support.");
@@ -187,6 +308,8 @@ void Input::run_basic_checks() const {
 }
 
 void Input::add_job(const Job& job) {
+  _prepared = false;
+  restore_jobs();
   if (job.type != JOB_TYPE::SINGLE) {
     throw InputException("Wrong job type.");
   }
@@ -200,6 +323,8 @@ void Input::add_job(const Job& job) {
 }
 
 void Input::add_shipment(const Job& pickup, const Job& delivery) {
+  _prepared = false;
+  restore_jobs();
   if (pickup.priority != delivery.priority) {
     throw InputException(
       std::
@@ -253,6 +378,7 @@ void Input::add_shipment(const Job& pickup, const Job& delivery) {
 }
 
 void Input::add_vehicle(const Vehicle& vehicle) {
+  _prepared = false;
   vehicles.push_back(vehicle);
 
   auto& current_v = vehicles.back();
@@ -410,11 +536,321 @@ void Input::add_vehicle(const Vehicle& vehicle) {
   }
 }
 
+Index Input::get_job_rank(JOB_TYPE type, Id id) const {
+  const auto& id_to_rank = (type == JOB_TYPE::SINGLE)   ? job_id_to_rank
+                           : (type == JOB_TYPE::PICKUP) ? pickup_id_to_rank
+                                                        : delivery_id_to_rank;
+  const auto search = id_to_rank.find(id);
+  if (search == id_to_rank.end()) {
+    throw InputException(
+      std::format("Unknown {} id: {}.", get_job_type_str(type), id));
+  }
+  return search->second;
+}
+
+void Input::erase_jobs(Index first_rank, Index last_rank) {
+  assert(first_rank < last_rank && last_rank <= jobs.size());
+
+  // Job is not assignable so remaining jobs are copied.
+  std::vector<Job> remaining_jobs;
+  remaining_jobs.reserve(jobs.size() - (last_rank - first_rank));
+  for (Index j = 0; j < jobs.size(); ++j) {
+    if (j < first_rank || last_rank <= j) {
+      remaining_jobs.push_back(jobs[j]);
+    }
+  }
+  jobs = std::move(remaining_jobs);
+
+  set_job_id_maps();
+}
+
+void Input::set_job_id_maps() {
+  job_id_to_rank.clear();
+  pickup_id_to_rank.clear();
+  delivery_id_to_rank.clear();
+  _has_jobs = false;
+  _has_shipments = false;
+
+  for (Index j = 0; j < jobs.size(); ++j) {
+    switch (jobs[j].type) {
+    case JOB_TYPE::SINGLE:
+      job_id_to_rank[jobs[j].id] = j;
+      _has_jobs = true;
+      break;
+    case JOB_TYPE::PICKUP:
+      pickup_id_to_rank[jobs[j].id] = j;
+      _has_shipments = true;
+      break;
+    case JOB_TYPE::DELIVERY:
+      delivery_id_to_rank[jobs[j].id] = j;
+      break;
+    }
+  }
+}
+
+void Input::remove_job(Id id) {
+  _prepared = false;
+  restore_jobs();
+  const auto rank = get_job_rank(JOB_TYPE::SINGLE, id);
+  _updated_tasks.emplace(JOB_TYPE::SINGLE, id);
+  erase_jobs(rank, rank + 1);
+}
+
+void Input::remove_shipment(Id pickup_id) {
+  _prepared = false;
+  restore_jobs();
+  const auto rank = get_job_rank(JOB_TYPE::PICKUP, pickup_id);
+  assert(rank < jobs.size() - 1 && jobs[rank + 1].type == JOB_TYPE::DELIVERY);
+  _updated_tasks.emplace(JOB_TYPE::PICKUP, pickup_id);
+  _updated_tasks.emplace(JOB_TYPE::DELIVERY, jobs[rank + 1].id);
+  erase_jobs(rank, rank + 2);
+}
+
+void Input::update_tws(JOB_TYPE type,
+                       Id id,
+                       const std::vector<TimeWindow>& tws) {
+  _prepared = false;
+  restore_jobs();
+  const auto rank = get_job_rank(type, id);
+  auto& job = jobs[rank];
+
+  utils::check_tws(tws, id, get_job_type_str(type));
+  job.tws = tws;
+  _has_TW = _has_TW || (!(tws.size() == 1) || !tws[0].is_default());
+
+  // Both tasks in a shipment are inserted again.
+  _updated_tasks.emplace(type, id);
+  if (type == JOB_TYPE::PICKUP) {
+    _updated_tasks.emplace(JOB_TYPE::DELIVERY, jobs[rank + 1].id);
+  }
+  if (type == JOB_TYPE::DELIVERY) {
+    _updated_tasks.emplace(JOB_TYPE::PICKUP, jobs[rank - 1].id);
+  }
+}
+
+void Input::aggregate_jobs() {
+  assert(_unaggregated_jobs.empty() && _aggregated_ranks.empty());
+
+  // Routes with merged jobs expanded could exceed user-defined
+  // max_tasks values.
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    const auto max_tasks = (v < _input_max_tasks.size())
+                             ? _input_max_tasks[v]
+                             : vehicles[v].max_tasks;
+    if (max_tasks != DEFAULT_MAX_TASKS) {
+      return;
+    }
+  }
+
+  // Jobs from vehicle steps are left untouched to match user routes.
+  std::unordered_set<Id> jobs_in_steps;
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    for (const auto& step : initial_steps(v)) {
+      if (step.job_type == JOB_TYPE::SINGLE) {
+        jobs_in_steps.insert(step.id);
+      }
+    }
+  }
+
+  // Durations for original jobs are required to expand solutions.
+  for (auto& job : jobs) {
+    set_durations_per_vehicle_type(job);
+  }
+
+  struct Group {
+    std::vector<Index> ranks;
+    Amount delivery;
+    Amount pickup;
+    Priority priority;
+    // Sum of job services, per vehicle type.
+    std::vector<Duration> services;
+  };
+
+  std::vector<Group> groups;
+  std::unordered_map<Index, std::vector<std::size_t>> groups_by_location;
+  std::vector<std::optional<std::size_t>> job_group(jobs.size());
+
+  // Jobs with both a pickup and a delivery are never merged, so
+  // serving jobs without pickup first ensures vehicle load stays
+  // between its values before and after the merged job.
+  const auto has_pickup_and_delivery = [&](const Job& job) {
+    return job.pickup != _zero && job.delivery != _zero;
+  };
+
+  const auto served_order = [&](std::vector<Index> ranks) {
+    std::ranges::stable_partition(ranks, [&](const auto r) {
+      return jobs[r].pickup == _zero;
+    });
+    return ranks;
+  };
+
+  // Time from first job arrival to start of last job service, for
+  // the worst vehicle type.
+  const auto last_start = [&](const std::vector<Index>& ranks,
+                              const std::vector<Duration>& services) {
+    const auto& first = jobs[ranks.front()];
+    const auto& last = jobs[ranks.back()];
+    Duration start = 0;
+    for (std::size_t t = 0; t < services.size(); ++t) {
+      start =
+        std::max(start, first.setups[t] + services[t] - last.services[t]);
+    }
+    return start;
+  };
+
+  const auto can_join = [&](const Group& group, Index j) {
+    const auto& job = jobs[j];
+    const auto& first = jobs[group.ranks.front()];
+    if (job.skills != first.skills || job.tws != first.tws ||
+        group.priority + job.priority > MAX_PRIORITY ||
+        has_pickup_and_delivery(job) || has_pickup_and_delivery(first)) {
+      return false;
+    }
+
+    // Merged job should fit in at least one vehicle.
+    if (std::ranges::none_of(vehicles, [&](const auto& v) {
+          return group.delivery + job.delivery <= v.capacity &&
+                 group.pickup + job.pickup <= v.capacity;
+        })) {
+      return false;
+    }
+
+    // Last served job should start within the same time windows.
+    if (job.tws.size() == 1 && job.tws[0].is_default()) {
+      return true;
+    }
+    auto ranks = group.ranks;
+    ranks.push_back(j);
+    auto services = group.services;
+    for (std::size_t t = 0; t < services.size(); ++t) {
+      services[t] += job.services[t];
+    }
+    const auto shift = last_start(served_order(std::move(ranks)), services);
+    return std::ranges::all_of(job.tws, [&](const auto& tw) {
+      return tw.start + shift <= tw.end;
+    });
+  };
+
+  for (Index j = 0; j < jobs.size(); ++j) {
+    const auto& job = jobs[j];
+    if (job.type != JOB_TYPE::SINGLE || jobs_in_steps.contains(job.id)) {
+      continue;
+    }
+
+    auto& location_groups = groups_by_location[job.index()];
+    const auto search =
+      std::ranges::find_if(location_groups, [&](const auto g) {
+        return can_join(groups[g], j);
+      });
+
+    if (search == location_groups.end()) {
+      location_groups.push_back(groups.size());
+      job_group[j] = groups.size();
+      groups.push_back(
+        {{j}, job.delivery, job.pickup, job.priority, job.services});
+    } else {
+      job_group[j] = *search;
+
+      auto& group = groups[*search];
+      group.ranks.push_back(j);
+      group.delivery += job.delivery;
+      group.pickup += job.pickup;
+      group.priority += job.priority;
+      for (std::size_t t = 0; t < group.services.size(); ++t) {
+        group.services[t] += job.services[t];
+      }
+    }
+  }
+
+  if (std::ranges::none_of(groups, [](const auto& group) {
+        return group.ranks.size() > 1;
+      })) {
+    return;
+  }
+
+  std::vector<Job> aggregated_jobs;
+  for (Index j = 0; j < jobs.size(); ++j) {
+    if (!job_group[j].has_value() ||
+        groups[job_group[j].value()].ranks.size() == 1) {
+      aggregated_jobs.push_back(jobs[j]);
+      _aggregated_ranks.emplace_back();
+      continue;
+    }
+
+    const auto& group = groups[job_group[j].value()];
+    if (group.ranks.front() != j) {
+      // Already merged into a previous job.
+      continue;
+    }
+
+    // Setup only applies to the first served job, other jobs are
+    // served right after at the same location.
+    auto ranks = served_order(group.ranks);
+    const auto& first = jobs[ranks.front()];
+    TypeToUserDurationMap setup_per_type;
+    TypeToUserDurationMap service_per_type;
+    for (std::size_t t = 1; t < _vehicle_types.size(); ++t) {
+      setup_per_type.try_emplace(_vehicle_types[t],
+                                 utils::scale_to_user_duration(
+                                   first.setups[t]));
+      service_per_type.try_emplace(_vehicle_types[t],
+                                   utils::scale_to_user_duration(
+                                     group.services[t]));
+    }
+    const auto shift = last_start(ranks, group.services);
+
+    // Time windows apply to the first job so they are shortened to
+    // make sure the last job starts on time.
+    std::vector<TimeWindow> tws;
+    if (first.tws.size() == 1 && first.tws[0].is_default()) {
+      tws = first.tws;
+    } else {
+      for (const auto& tw : first.tws) {
+        tws.emplace_back(utils::scale_to_user_duration(tw.start),
+                         utils::scale_to_user_duration(tw.end - shift));
+      }
+    }
+
+    aggregated_jobs.emplace_back(first.id,
+                                 first.location,
+                                 utils::scale_to_user_duration(
+                                   first.default_setup),
+                                 utils::scale_to_user_duration(
+                                   group.services[0]),
+                                 group.delivery,
+                                 group.pickup,
+                                 first.skills,
+                                 group.priority,
+                                 tws,
+                                 "",
+                                 setup_per_type,
+                                 service_per_type);
+    _aggregated_ranks.push_back(std::move(ranks));
+  }
+
+  _unaggregated_jobs = std::move(jobs);
+  jobs = std::move(aggregated_jobs);
+  set_job_id_maps();
+}
+
+void Input::restore_jobs() {
+  if (_unaggregated_jobs.empty()) {
+    return;
+  }
+
+  jobs = std::move(_unaggregated_jobs);
+  _unaggregated_jobs.clear();
+  _aggregated_ranks.clear();
+  set_job_id_maps();
+}
+
 void Input::set_durations_matrix(const std::string& profile,
                                  Matrix<UserDuration>&& m) {
   if (m.size() == 0) {
     throw InputException("Empty durations matrix for " + profile + " profile.");
   }
+  _prepared = false;
+  _routed_durations_profiles.erase(profile);
   _durations_matrices.insert_or_assign(profile, std::move(m));
 }
 
@@ -423,6 +859,9 @@ void Input::set_distances_matrix(const std::string& profile,
   if (m.size() == 0) {
     throw InputException("Empty distances matrix for " + profile + " profile.");
   }
+  _prepared = false;
+  _routed_distances_profiles.erase(profile);
+  _custom_distances_profiles.insert(profile);
   _distances_matrices.insert_or_assign(profile, std::move(m));
 }
 
@@ -430,6 +869,7 @@ void Input::set_costs_matrix(const std::string& profile, Matrix<UserCost>&& m) {
   if (m.size() == 0) {
     throw InputException("Empty costs matrix for " + profile + " profile.");
   }
+  _prepared = false;
   _costs_matrices.insert_or_assign(profile, std::move(m));
 }
 
@@ -466,11 +906,11 @@ bool Input::has_homogeneous_costs() const {
 }
 
 bool Input::has_initial_routes() const {
-  return _has_initial_routes;
+  return _has_initial_routes || !_reoptimized_steps.empty();
 }
 
 bool Input::vehicle_ok_with_vehicle(Index v1_index, Index v2_index) const {
-  return _vehicle_to_vehicle_compatibility[v1_index][v2_index];
+  return _vehicle_to_vehicle_compatibility(v1_index, v2_index);
 }
 
 UserCost Input::check_cost_bound(const Matrix<UserCost>& matrix) const {
@@ -520,109 +960,246 @@ UserCost Input::check_cost_bound(const Matrix<UserCost>& matrix) const {
   return utils::add_without_overflow(bound, end_bound);
 }
 
-void Input::set_skills_compatibility() {
+void Input::set_vehicle_classes() {
+  _vehicle_classes.resize(vehicles.size());
+  _classes_representative.clear();
+
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    const auto search =
+      std::ranges::find_if(_classes_representative, [&](const auto rep) {
+        return vehicles[rep].is_equivalent_to(vehicles[v]);
+      });
+
+    if (search == _classes_representative.end()) {
+      _vehicle_classes[v] = _classes_representative.size();
+      _classes_representative.push_back(v);
+    } else {
+      _vehicle_classes[v] =
+        std::distance(_classes_representative.begin(), search);
+    }
+  }
+}
+
+void Input::copy_compatibility_from_representatives() {
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    if (const auto rep = _classes_representative[_vehicle_classes[v]];
+        rep != v) {
+      _vehicle_to_job_compatibility.copy_row(rep, v);
+    }
+  }
+}
+
+void Input::set_skills_compatibility(unsigned nb_thread) {
   // Default to no restriction when no skills are provided.
-  _vehicle_to_job_compatibility = std::vector<
-    std::vector<unsigned char>>(vehicles.size(),
-                                std::vector<unsigned char>(jobs.size(), true));
+  _vehicle_to_job_compatibility = BitMatrix(vehicles.size(), jobs.size(), true);
   if (_has_skills) {
-    for (std::size_t v = 0; v < vehicles.size(); ++v) {
-      const auto& v_skills = vehicles[v].skills;
+    // Each thread fills rows for a range of vehicle classes.
+    auto set_rows = [&](std::size_t begin, std::size_t end) {
+      for (std::size_t c = begin; c < end; ++c) {
+        const auto v = _classes_representative[c];
+        const auto& v_skills = vehicles[v].skills;
 
-      for (std::size_t j = 0; j < jobs.size(); ++j) {
-        bool is_compatible = true;
-        for (const auto& s : jobs[j].skills) {
-          if (!v_skills.contains(s)) {
-            is_compatible = false;
-            break;
+        for (std::size_t j = 0; j < jobs.size(); ++j) {
+          bool is_compatible = true;
+          for (const auto& s : jobs[j].skills) {
+            if (!v_skills.contains(s)) {
+              is_compatible = false;
+              break;
+            }
           }
+          _vehicle_to_job_compatibility.set(v, j, is_compatible);
         }
-        _vehicle_to_job_compatibility[v][j] = is_compatible;
       }
-    }
+    };
+    utils::run_on_ranges(nb_thread, nb_vehicle_classes(), set_rows);
+    copy_compatibility_from_representatives();
   }
 }
 
-void Input::set_extra_compatibility() {
+void Input::set_extra_compatibility(unsigned nb_thread) {
   // Derive potential extra incompatibilities : jobs or shipments with
   // amount that does not fit into vehicle or that cannot be added to
   // an empty route for vehicle based on the timing constraints (when
   // they apply).
-  compatible_vehicles_for_job = std::vector<std::vector<Index>>(jobs.size());
-
-  for (std::size_t v = 0; v < vehicles.size(); ++v) {
-    const TWRoute empty_route(*this, v, _zero.size());
-    for (Index j = 0; j < jobs.size(); ++j) {
-      if (!_vehicle_to_job_compatibility[v][j]) {
-        continue;
-      }
+  auto set_rows = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t c = begin; c < end; ++c) {
+      const auto v = _classes_representative[c];
+      const TWRoute empty_route(*this, v, _zero.size());
+      for (Index j = 0; j < jobs.size(); ++j) {
+        if (!_vehicle_to_job_compatibility(v, j)) {
+          continue;
+        }
 
-      bool is_compatible =
-        empty_route.is_valid_addition_for_capacity(*this,
-                                                   jobs[j].pickup,
-                                                   jobs[j].delivery,
-                                                   0);
-
-      const bool is_shipment_pickup = (jobs[j].type == JOB_TYPE::PICKUP);
-
-      if (is_compatible && _has_TW) {
-        if (jobs[j].type == JOB_TYPE::SINGLE) {
-          is_compatible =
-            is_compatible &&
-            empty_route.is_valid_addition_for_tw_without_max_load(*this, j, 0);
-        } else {
-          assert(is_shipment_pickup);
-          std::vector<Index> p_d({j, static_cast<Index>(j + 1)});
-          is_compatible =
-            is_compatible && empty_route.is_valid_addition_for_tw(*this,
-                                                                  _zero,
-                                                                  p_d.begin(),
-                                                                  p_d.end(),
-                                                                  0,
-                                                                  0);
+        bool is_compatible =
+          empty_route.is_valid_addition_for_capacity(*this,
+                                                     jobs[j].pickup,
+                                                     jobs[j].delivery,
+                                                     0);
+
+        const bool is_shipment_pickup = (jobs[j].type == JOB_TYPE::PICKUP);
+
+        if (is_compatible && _has_TW) {
+          if (jobs[j].type == JOB_TYPE::SINGLE) {
+            is_compatible =
+              is_compatible &&
+              empty_route.is_valid_addition_for_tw_without_max_load(*this,
+                                                                    j,
+                                                                    0);
+          } else {
+            assert(is_shipment_pickup);
+            std::vector<Index> p_d({j, static_cast<Index>(j + 1)});
+            is_compatible =
+              is_compatible && empty_route.is_valid_addition_for_tw(*this,
+                                                                    _zero,
+                                                                    p_d.begin(),
+                                                                    p_d.end(),
+                                                                    0,
+                                                                    0);
+          }
         }
-      }
 
-      _vehicle_to_job_compatibility[v][j] = is_compatible;
-      if (is_shipment_pickup) {
-        // Skipping matching delivery which is next in line in jobs.
-        _vehicle_to_job_compatibility[v][j + 1] = is_compatible;
-        ++j;
+        _vehicle_to_job_compatibility.set(v, j, is_compatible);
+        if (is_shipment_pickup) {
+          // Skipping matching delivery which is next in line in jobs.
+          _vehicle_to_job_compatibility.set(v, j + 1, is_compatible);
+          ++j;
+        }
       }
+    }
+  };
+  utils::run_on_ranges(nb_thread, nb_vehicle_classes(), set_rows);
+  copy_compatibility_from_representatives();
 
-      if (is_compatible) {
+  compatible_vehicles_for_job = std::vector<std::vector<Index>>(jobs.size());
+  for (Index j = 0; j < jobs.size(); ++j) {
+    if (jobs[j].type == JOB_TYPE::PICKUP) {
+      // Only delivery is stored for shipments.
+      continue;
+    }
+    for (Index v = 0; v < vehicles.size(); ++v) {
+      if (_vehicle_to_job_compatibility(v, j)) {
         compatible_vehicles_for_job[j].push_back(v);
       }
     }
   }
 }
 
-void Input::set_vehicles_compatibility() {
+void Input::set_vehicles_compatibility(unsigned nb_thread) {
   _vehicle_to_vehicle_compatibility =
-    std::vector<std::vector<bool>>(vehicles.size(),
-                                   std::vector<bool>(vehicles.size(), false));
-  for (std::size_t v1 = 0; v1 < vehicles.size(); ++v1) {
-    _vehicle_to_vehicle_compatibility[v1][v1] = true;
-    for (std::size_t v2 = v1 + 1; v2 < vehicles.size(); ++v2) {
-      for (std::size_t j = 0; j < jobs.size(); ++j) {
-        if (_vehicle_to_job_compatibility[v1][j] &&
-            _vehicle_to_job_compatibility[v2][j]) {
-          _vehicle_to_vehicle_compatibility[v1][v2] = true;
-          _vehicle_to_vehicle_compatibility[v2][v1] = true;
-          break;
+    BitMatrix(vehicles.size(), vehicles.size(), false);
+
+  // Each thread fills rows for a range of vehicle classes.
+  auto set_rows = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t c = begin; c < end; ++c) {
+      const auto v1 = _classes_representative[c];
+      for (std::size_t v2 = 0; v2 < vehicles.size(); ++v2) {
+        if (_vehicle_to_job_compatibility.rows_intersect(v1, v2)) {
+          _vehicle_to_vehicle_compatibility.set(v1, v2, true);
         }
       }
     }
+  };
+  utils::run_on_ranges(nb_thread, nb_vehicle_classes(), set_rows);
+
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    if (const auto rep = _classes_representative[_vehicle_classes[v]];
+        rep != v) {
+      _vehicle_to_vehicle_compatibility.copy_row(rep, v);
+    }
+  }
+
+  // A vehicle is always compatible with itself, even without any
+  // compatible job.
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    _vehicle_to_vehicle_compatibility.set(v, v, true);
+  }
+}
+
+void Input::set_jobs_neighbours(unsigned nb_thread) {
+  _vehicle_cost_profiles.clear();
+  _jobs_neighbours.clear();
+  if (!_nb_neighbours.has_value()) {
+    return;
+  }
+
+  std::vector<Index> profiles_representative;
+  _vehicle_cost_profiles.resize(vehicles.size());
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    const auto search =
+      std::ranges::find_if(profiles_representative, [&](const auto rep) {
+        return vehicles[rep].has_same_profile(vehicles[v]);
+      });
+
+    _vehicle_cost_profiles[v] =
+      std::distance(profiles_representative.begin(), search);
+    if (search == profiles_representative.end()) {
+      profiles_representative.push_back(v);
+    }
+  }
+
+  const std::size_t nb_neighbours =
+    std::min<std::size_t>(_nb_neighbours.value(),
+                          jobs.empty() ? 0 : jobs.size() - 1);
+
+  _jobs_neighbours.reserve(profiles_representative.size());
+  for (const auto rep : profiles_representative) {
+    const auto& vehicle = vehicles[rep];
+    std::vector<std::vector<Index>> closest(jobs.size());
+
+    // Each thread finds closest jobs for a range of jobs, based on
+    // the cheapest direction.
+    auto set_closest = [&](std::size_t begin, std::size_t end) {
+      std::vector<std::pair<Cost, Index>> candidates;
+      candidates.reserve(jobs.size());
+
+      for (std::size_t j = begin; j < end; ++j) {
+        const auto j_index = jobs[j].index();
+
+        candidates.clear();
+        for (Index k = 0; k < jobs.size(); ++k) {
+          if (k != j) {
+            const auto k_index = jobs[k].index();
+            candidates.emplace_back(std::min(vehicle.cost(j_index, k_index),
+                                             vehicle.cost(k_index, j_index)),
+                                    k);
+          }
+        }
+
+        std::ranges::nth_element(candidates,
+                                 candidates.begin() + nb_neighbours);
+
+        closest[j].reserve(nb_neighbours);
+        for (std::size_t i = 0; i < nb_neighbours; ++i) {
+          closest[j].push_back(candidates[i].second);
+        }
+      }
+    };
+    utils::run_on_ranges(nb_thread, jobs.size(), set_closest);
+
+    // Make neighbourhood relation symmetric.
+    auto& neighbours = _jobs_neighbours.emplace_back(closest);
+    for (Index j = 0; j < jobs.size(); ++j) {
+      for (const auto k : closest[j]) {
+        neighbours[k].push_back(j);
+      }
+    }
+    for (auto& job_neighbours : neighbours) {
+      std::ranges::sort(job_neighbours);
+      const auto [first, last] = std::ranges::unique(job_neighbours);
+      job_neighbours.erase(first, last);
+    }
   }
 }
 
 void Input::set_vehicles_costs() {
   for (auto& vehicle : vehicles) {
-    auto duration_m = _durations_matrices.find(vehicle.profile);
+    const auto& m_profile = matrices_profile(vehicle.profile);
+
+    auto duration_m = _durations_matrices.find(m_profile);
     assert(duration_m != _durations_matrices.end());
     vehicle.cost_wrapper.set_durations_matrix(&(duration_m->second));
 
-    auto distance_m = _distances_matrices.find(vehicle.profile);
+    auto distance_m = _distances_matrices.find(m_profile);
     assert(distance_m != _distances_matrices.end());
     vehicle.cost_wrapper.set_distances_matrix(&(distance_m->second));
 
@@ -644,10 +1221,24 @@ void Input::set_vehicles_costs() {
     } else {
       vehicle.cost_wrapper.set_costs_matrix(&(duration_m->second));
     }
+
+    vehicle.cost_wrapper.set_symmetric_costs(
+      _profiles_with_symmetric_costs.contains(vehicle.profile));
   }
 }
 
 void Input::set_vehicles_max_tasks() {
+  if (_input_max_tasks.empty()) {
+    std::ranges::transform(vehicles,
+                           std::back_inserter(_input_max_tasks),
+                           &Vehicle::max_tasks);
+  } else {
+    // Bounds from a previous solving may not hold with other jobs.
+    for (Index v = 0; v < vehicles.size(); ++v) {
+      vehicles[v].max_tasks = _input_max_tasks[v];
+    }
+  }
+
   if (const auto amount_size = get_amount_size();
       _has_jobs && !_has_shipments && amount_size > 0) {
     // For job-only instances where capacity restrictions apply:
@@ -771,97 +1362,117 @@ void Input::set_vehicles_max_tasks() {
   }
 }
 
-void Input::set_jobs_vehicles_evals() {
-  // For a single job j, evals[j][v] evaluates fetching job j in an
-  // empty route from vehicle at rank v. For a pickup job j,
-  // evals[j][v] evaluates fetching job j **and** associated delivery
-  // in an empty route from vehicle at rank v.
+void Input::set_jobs_vehicles_evals(unsigned nb_thread) {
+  // For a single job j, evals[j][c] evaluates fetching job j in an
+  // empty route from vehicles in class c. For a pickup job j,
+  // evals[j][c] evaluates fetching job j **and** associated delivery
+  // in an empty route from vehicles in class c. Vehicles in a class
+  // share the same compatibility, so evals[j][c] holds the cost upper
+  // bound exactly when all those vehicles are incompatible with job j,
+  // as was the case for per-vehicle evaluations.
+#ifndef NDEBUG
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    const auto rep = _classes_representative[_vehicle_classes[v]];
+    for (Index j = 0; j < jobs.size(); ++j) {
+      assert(vehicle_ok_with_job(v, j) == vehicle_ok_with_job(rep, j));
+    }
+  }
+#endif
   _jobs_vehicles_evals =
-    std::vector<std::vector<Eval>>(jobs.size(),
-                                   std::vector<Eval>(vehicles.size(),
-                                                     Eval(_cost_upper_bound)));
+    Matrix<Eval>(jobs.size(), nb_vehicle_classes(), Eval(_cost_upper_bound));
+
+  // Each thread fills rows for a range of jobs. A delivery row is
+  // filled along with its pickup row, possibly outside the range.
+  auto set_rows = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t j = begin; j < end; ++j) {
+      const auto& job = jobs[j];
+      if (job.type == JOB_TYPE::DELIVERY) {
+        continue;
+      }
 
-  for (std::size_t j = 0; j < jobs.size(); ++j) {
-    const auto& job = jobs[j];
-    const Index j_index = job.index();
-    const bool is_pickup = (job.type == JOB_TYPE::PICKUP);
+      const Index j_index = job.index();
+      const bool is_pickup = (job.type == JOB_TYPE::PICKUP);
 
-    Index last_job_index = j_index;
-    if (is_pickup) {
-      assert((j + 1 < jobs.size()) && (jobs[j + 1].type == JOB_TYPE::DELIVERY));
-      last_job_index = jobs[j + 1].index();
-    }
+      Index last_job_index = j_index;
+      if (is_pickup) {
+        assert((j + 1 < jobs.size()) &&
+               (jobs[j + 1].type == JOB_TYPE::DELIVERY));
+        last_job_index = jobs[j + 1].index();
+      }
 
-    for (std::size_t v = 0; v < vehicles.size(); ++v) {
-      const auto& vehicle = vehicles[v];
+      for (std::size_t c = 0; c < nb_vehicle_classes(); ++c) {
+        const auto v = _classes_representative[c];
+        const auto& vehicle = vehicles[v];
 
-      if (!vehicle_ok_with_job(v, j)) {
-        continue;
-      }
+        if (!vehicle_ok_with_job(v, j)) {
+          continue;
+        }
 
-      auto& current_eval = _jobs_vehicles_evals[j][v];
+        auto& current_eval = _jobs_vehicles_evals[j][c];
 
-      Duration added_task_duration = job.services[vehicle.type];
+        Duration added_task_duration = job.services[vehicle.type];
 
-      current_eval = is_pickup ? vehicle.eval(j_index, last_job_index) : Eval();
-      if (vehicle.has_start()) {
-        const auto start_index = vehicle.start.value().index();
-        current_eval += vehicle.eval(start_index, j_index);
+        current_eval =
+          is_pickup ? vehicle.eval(j_index, last_job_index) : Eval();
+        if (vehicle.has_start()) {
+          const auto start_index = vehicle.start.value().index();
+          current_eval += vehicle.eval(start_index, j_index);
 
-        if (start_index != j_index) {
-          added_task_duration += job.setups[vehicle.type];
+          if (start_index != j_index) {
+            added_task_duration += job.setups[vehicle.type];
+          }
+        }
+        if (vehicle.has_end()) {
+          current_eval +=
+            vehicle.eval(last_job_index, vehicle.end.value().index());
         }
-      }
-      if (vehicle.has_end()) {
-        current_eval +=
-          vehicle.eval(last_job_index, vehicle.end.value().index());
-      }
 
-      if (is_pickup) {
-        const auto& d_job = jobs[j + 1];
-        added_task_duration += d_job.services[vehicle.type];
-        if (j_index != d_job.index()) {
-          added_task_duration += d_job.setups[vehicle.type];
+        if (is_pickup) {
+          const auto& d_job = jobs[j + 1];
+          added_task_duration += d_job.services[vehicle.type];
+          if (j_index != d_job.index()) {
+            added_task_duration += d_job.setups[vehicle.type];
+          }
         }
-      }
-      current_eval += vehicle.task_eval(added_task_duration);
+        current_eval += vehicle.task_eval(added_task_duration);
 
-      if (is_pickup) {
-        // Assign same eval to delivery.
-        _jobs_vehicles_evals[j + 1][v] = current_eval;
+        if (is_pickup) {
+          // Assign same eval to delivery.
+          _jobs_vehicles_evals[j + 1][c] = current_eval;
+        }
       }
     }
+  };
+  utils::run_on_ranges(nb_thread, jobs.size(), set_rows);
+}
+
+void Input::set_durations_per_vehicle_type(Job& job) const {
+  const auto nb_types = _vehicle_types.size();
+
+  // Populate duration vectors with default values at first.
+  job.setups = std::vector<Duration>(nb_types, job.default_setup);
+  job.services = std::vector<Duration>(nb_types, job.default_service);
+
+  // Iterate on all user-defined vehicle types to override relevant
+  // setup and service values.
+  for (std::size_t type_rank = 1; type_rank < nb_types; ++type_rank) {
+    const auto& type = _vehicle_types[type_rank];
+
+    if (const auto search = job.setup_per_type.find(type);
+        search != job.setup_per_type.end()) {
+      job.setups[type_rank] = search->second;
+    }
 
-    if (is_pickup) {
-      // Skip delivery.
-      ++j;
+    if (const auto search = job.service_per_type.find(type);
+        search != job.service_per_type.end()) {
+      job.services[type_rank] = search->second;
     }
   }
 }
 
 void Input::set_jobs_durations_per_vehicle_type() {
-  const auto nb_types = _vehicle_types.size();
-
   for (auto& job : jobs) {
-    // Populate duration vectors with default values at first.
-    job.setups = std::vector<Duration>(nb_types, job.default_setup);
-    job.services = std::vector<Duration>(nb_types, job.default_service);
-
-    // Iterate on all user-defined vehicle types to override relevant
-    // setup and service values.
-    for (std::size_t type_rank = 1; type_rank < nb_types; ++type_rank) {
-      const auto& type = _vehicle_types[type_rank];
-
-      if (const auto search = job.setup_per_type.find(type);
-          search != job.setup_per_type.end()) {
-        job.setups[type_rank] = search->second;
-      }
-
-      if (const auto search = job.service_per_type.find(type);
-          search != job.service_per_type.end()) {
-        job.services[type_rank] = search->second;
-      }
-    }
+    set_durations_per_vehicle_type(job);
   }
 }
 
@@ -870,8 +1481,11 @@ void Input::set_vehicle_steps_ranks() {
   std::unordered_set<Id> planned_pickup_ids;
   std::unordered_set<Id> planned_delivery_ids;
 
-  for (auto& current_vehicle : vehicles) {
-    for (auto& step : current_vehicle.steps) {
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    const auto& current_vehicle = vehicles[v];
+    auto& steps = _reoptimized_steps.empty() ? vehicles[v].steps
+                                             : _reoptimized_steps[v];
+    for (auto& step : steps) {
       if (step.type == STEP_TYPE::BREAK) {
         auto search = current_vehicle.break_id_to_rank.find(step.id);
         if (search == current_vehicle.break_id_to_rank.end()) {
@@ -997,8 +1611,62 @@ void Input::init_missing_matrices(const std::string& profile) {
   }
 }
 
+const std::string& Input::matrices_profile(const std::string& profile) const {
+  const auto search = _shared_matrices_profiles.find(profile);
+  return (search == _shared_matrices_profiles.end()) ? profile
+                                                     : search->second;
+}
+
+void Input::set_shared_matrices_profiles() {
+  // Only profiles for which both durations and distances are
+  // retrieved from a routing engine are candidates for sharing.
+  std::unordered_map<std::string, std::string> source_to_profile;
+
+  auto matrices_source = [&](const std::string& profile) {
+    auto rw = std::ranges::find_if(_routing_wrappers, [&](const auto& wr) {
+      return wr->profile == profile;
+    });
+    assert(rw != _routing_wrappers.end());
+    return (*rw)->matrices_source();
+  };
+
+  // Profiles already routed in a previous solving keep their own
+  // matrices and can be shared with profiles added since then.
+  for (const auto& profile : _routed_durations_profiles) {
+    if (_routed_distances_profiles.contains(profile)) {
+      source_to_profile.try_emplace(matrices_source(profile), profile);
+    }
+  }
+
+  for (const auto& profile : _profiles) {
+    if (_shared_matrices_profiles.contains(profile) ||
+        _routed_durations_profiles.contains(profile)) {
+      continue;
+    }
+
+    const auto durations_m = _durations_matrices.find(profile);
+    const auto distances_m = _distances_matrices.find(profile);
+    assert(durations_m != _durations_matrices.end());
+    assert(distances_m != _distances_matrices.end());
+    if (durations_m->second.size() != 0 || distances_m->second.size() != 0) {
+      continue;
+    }
+
+    const auto [search, insertion_ok] =
+      source_to_profile.try_emplace(matrices_source(profile), profile);
+    if (!insertion_ok) {
+      // Same routing data as a previous profile: matrices will only
+      // be computed and stored once.
+      _shared_matrices_profiles.try_emplace(profile, search->second);
+      _durations_matrices.erase(durations_m);
+      _distances_matrices.erase(distances_m);
+    }
+  }
+}
+
 routing::Matrices Input::get_matrices_by_profile(const std::string& profile,
-                                                 bool sparse_filling) {
+                                                 bool sparse_filling,
+                                                 unsigned nb_thread) {
   auto rw = std::ranges::find_if(_routing_wrappers, [&](const auto& wr) {
     return wr->profile == profile;
   });
@@ -1014,10 +1682,10 @@ routing::Matrices Input::get_matrices_by_profile(const std::string& profile,
                                                      this->vehicles,
                                                      this->jobs,
                                                      _vehicles_geometry)
-                        : (*rw)->get_matrices(_locations);
+                        : (*rw)->get_matrices(_locations, nb_thread);
 }
 
-void Input::set_matrices(unsigned nb_thread, bool sparse_filling) {
+void Input::init_matrices(bool sparse_filling) {
   if ((!_durations_matrices.empty() || !_distances_matrices.empty() ||
        !_costs_matrices.empty()) &&
       !_has_custom_location_index) {
@@ -1046,25 +1714,141 @@ void Input::set_matrices(unsigned nb_thread, bool sparse_filling) {
     }
   }
 
+  for (const auto& profile : _profiles) {
+    init_missing_matrices(profile);
+  }
+
+  if (!sparse_filling) {
+    set_shared_matrices_profiles();
+  }
+}
+
+void Input::update_matrices() {
+  bool new_profiles = false;
+  for (const auto& profile : _profiles) {
+    if (!_durations_matrices.contains(profile) &&
+        !_shared_matrices_profiles.contains(profile)) {
+      // Profile for a vehicle added since matrices initialization.
+      init_missing_matrices(profile);
+      new_profiles = true;
+    }
+  }
+
+  if (new_profiles) {
+    set_shared_matrices_profiles();
+  }
+
+  if (_locations.size() != _nb_routed_locations) {
+    // Matrices from routing engines are missing new locations.
+    for (const auto& profile : _routed_durations_profiles) {
+      _durations_matrices.find(profile)->second = Matrix<UserDuration>();
+    }
+    for (const auto& profile : _routed_distances_profiles) {
+      _distances_matrices.find(profile)->second = Matrix<UserDistance>();
+    }
+  }
+}
+
+void Input::set_matrices(unsigned nb_thread, bool sparse_filling) {
+  // Profiles using matrices from another profile are handled along
+  // with that profile.
+  std::unordered_map<std::string, std::vector<std::string>>
+    profiles_sharing_matrices;
+  for (const auto& [profile, m_profile] : _shared_matrices_profiles) {
+    profiles_sharing_matrices[m_profile].push_back(profile);
+  }
+
   // Split computing matrices across threads based on number of
   // profiles.
   const auto nb_buckets =
-    std::min(nb_thread, static_cast<unsigned>(_profiles.size()));
+    std::min(nb_thread,
+             static_cast<unsigned>(_profiles.size() -
+                                   _shared_matrices_profiles.size()));
 
   std::vector<std::vector<std::string>>
     thread_profiles(nb_buckets, std::vector<std::string>());
 
+  // Remaining threads are available to each profile computation.
+  const unsigned nb_thread_per_profile =
+    std::max(1u, nb_thread / std::max(1u, nb_buckets));
+
   std::size_t t_rank = 0;
   for (const auto& profile : _profiles) {
-    thread_profiles[t_rank % nb_buckets].push_back(profile);
-    ++t_rank;
-
-    init_missing_matrices(profile);
+    if (!_shared_matrices_profiles.contains(profile)) {
+      thread_profiles[t_rank % nb_buckets].push_back(profile);
+      ++t_rank;
+
+      // Required matrices not manually set have been defined as
+      // empty in init_missing_matrices.
+      if (_durations_matrices.find(profile)->second.size() == 0) {
+        _routed_durations_profiles.insert(profile);
+      }
+      if (_distances_matrices.find(profile)->second.size() == 0) {
+        _routed_distances_profiles.insert(profile);
+      }
+    }
   }
+  _nb_routed_locations = _locations.size();
+  _profiles_with_symmetric_costs.clear();
 
   std::exception_ptr ep = nullptr;
   std::mutex ep_m;
   std::mutex cost_bound_m;
+  std::mutex symmetry_m;
+
+  const std::vector<Index> used_indices(_matrices_used_index.begin(),
+                                        _matrices_used_index.end());
+
+  auto check_symmetry = [&](const std::string& profile,
+                            const Matrix<UserDuration>& durations,
+                            const Matrix<UserDistance>& distances) {
+    // Costs are either based on a custom matrix, or on durations and
+    // possibly distances.
+    const auto c_m = _costs_matrices.find(profile);
+    const bool symmetric_costs =
+      (c_m != _costs_matrices.end())
+        ? c_m->second.is_symmetric(used_indices)
+        : durations.is_symmetric(used_indices) &&
+            (!_profiles_requiring_distances.contains(profile) ||
+             distances.is_symmetric(used_indices));
+
+    if (symmetric_costs) {
+      const std::scoped_lock<std::mutex> lock(symmetry_m);
+      _profiles_with_symmetric_costs.insert(profile);
+    }
+  };
+
+  auto update_cost_bound = [&](const std::string& profile,
+                               const Matrix<UserDuration>& durations) {
+    const auto c_m = _costs_matrices.find(profile);
+
+    if (c_m != _costs_matrices.end()) {
+      if (c_m->second.size() <= _max_matrices_used_index) {
+        throw InputException("location_index exceeding costs matrix size for " +
+                             profile + " profile.");
+      }
+
+      // Check for potential overflow in solution cost.
+      const UserCost current_bound = check_cost_bound(c_m->second);
+      const std::scoped_lock<std::mutex> lock(cost_bound_m);
+      _cost_upper_bound =
+        std::max(_cost_upper_bound,
+                 utils::scale_from_user_cost(current_bound));
+    } else {
+      // Durations matrix will be used for costs.
+      const UserCost current_bound = check_cost_bound(durations);
+
+      auto search = _max_cost_per_hour.find(profile);
+      assert(search != _max_cost_per_hour.end());
+      const auto max_cost_per_hour_for_profile = search->second;
+
+      const std::scoped_lock<std::mutex> lock(cost_bound_m);
+      _cost_upper_bound =
+        std::max(_cost_upper_bound,
+                 max_cost_per_hour_for_profile *
+                   utils::scale_from_user_duration(current_bound));
+    }
+  };
 
   auto run_on_profiles = [&](const std::vector<std::string>& profiles) {
     try {
@@ -1085,7 +1869,9 @@ void Input::set_matrices(unsigned nb_thread, bool sparse_filling) {
             durations_m->second = Matrix<UserDuration>(1);
             distances_m->second = Matrix<UserDistance>(1);
           } else {
-            auto matrices = get_matrices_by_profile(profile, sparse_filling);
+            auto matrices = get_matrices_by_profile(profile,
+                                                    sparse_filling,
+                                                    nb_thread_per_profile);
 
             if (!_has_custom_location_index) {
               // Location indices are set based on order in _locations.
@@ -1138,34 +1924,19 @@ void Input::set_matrices(unsigned nb_thread, bool sparse_filling) {
             " profile.");
         }
 
-        const auto c_m = _costs_matrices.find(profile);
+        update_cost_bound(profile, durations_m->second);
+        if (!sparse_filling) {
+          check_symmetry(profile, durations_m->second, distances_m->second);
+        }
 
-        if (c_m != _costs_matrices.end()) {
-          if (c_m->second.size() <= _max_matrices_used_index) {
-            throw InputException(
-              "location_index exceeding costs matrix size for " + profile +
-              " profile.");
+        if (const auto search = profiles_sharing_matrices.find(profile);
+            search != profiles_sharing_matrices.end()) {
+          for (const auto& other_profile : search->second) {
+            update_cost_bound(other_profile, durations_m->second);
+            check_symmetry(other_profile,
+                           durations_m->second,
+                           distances_m->second);
           }
-
-          // Check for potential overflow in solution cost.
-          const UserCost current_bound = check_cost_bound(c_m->second);
-          const std::scoped_lock<std::mutex> lock(cost_bound_m);
-          _cost_upper_bound =
-            std::max(_cost_upper_bound,
-                     utils::scale_from_user_cost(current_bound));
-        } else {
-          // Durations matrix will be used for costs.
-          const UserCost current_bound = check_cost_bound(durations_m->second);
-
-          auto search = _max_cost_per_hour.find(profile);
-          assert(search != _max_cost_per_hour.end());
-          const auto max_cost_per_hour_for_profile = search->second;
-
-          const std::scoped_lock<std::mutex> lock(cost_bound_m);
-          _cost_upper_bound =
-            std::max(_cost_upper_bound,
-                     max_cost_per_hour_for_profile *
-                       utils::scale_from_user_duration(current_bound));
         }
       }
     } catch (...) {
@@ -1190,6 +1961,113 @@ void Input::set_matrices(unsigned nb_thread, bool sparse_filling) {
   }
 }
 
+std::string Input::canonical_key() const {
+  std::string key;
+
+  utils::append_to_key(key, _router);
+  std::vector<std::string_view> server_profiles;
+  for (const auto& [profile, server] : _servers) {
+    server_profiles.push_back(profile);
+  }
+  std::ranges::sort(server_profiles);
+  utils::append_to_key(key, server_profiles.size());
+  for (const auto profile : server_profiles) {
+    const auto& server = _servers.find(profile)->second;
+    utils::append_to_key(key, profile);
+    utils::append_to_key(key, server.host);
+    utils::append_to_key(key, server.port);
+    utils::append_to_key(key, server.path);
+  }
+  utils::append_to_key(key, _geometry);
+  utils::append_to_key(key, _apply_TSPFix);
+  utils::append_to_key(key, _max_moves);
+  utils::append_to_key(key, _nb_neighbours);
+  utils::append_to_key(key, _adaptive_operators);
+  utils::append_to_key(key, _ruin_and_recreate);
+  utils::append_to_key(key, _aggregate_jobs);
+
+  const auto& input_jobs =
+    _unaggregated_jobs.empty() ? jobs : _unaggregated_jobs;
+  utils::append_to_key(key, input_jobs.size());
+  for (const auto& job : input_jobs) {
+    append_location(key, job.location);
+    utils::append_to_key(key, job.id);
+    utils::append_to_key(key, job.type);
+    utils::append_to_key(key, job.default_setup);
+    utils::append_to_key(key, job.default_service);
+    append_amount(key, job.delivery);
+    append_amount(key, job.pickup);
+    append_skills(key, job.skills);
+    utils::append_to_key(key, job.priority);
+    append_tws(key, job.tws);
+    utils::append_to_key(key, job.description);
+    append_durations_per_type(key, job.setup_per_type);
+    append_durations_per_type(key, job.service_per_type);
+  }
+
+  utils::append_to_key(key, vehicles.size());
+  for (std::size_t v = 0; v < vehicles.size(); ++v) {
+    const auto& vehicle = vehicles[v];
+    utils::append_to_key(key, vehicle.id);
+    append_location(key, vehicle.start);
+    append_location(key, vehicle.end);
+    utils::append_to_key(key, vehicle.profile);
+    append_amount(key, vehicle.capacity);
+    append_skills(key, vehicle.skills);
+    utils::append_to_key(key, vehicle.tw.start);
+    utils::append_to_key(key, vehicle.tw.end);
+
+    utils::append_to_key(key, vehicle.breaks.size());
+    for (const auto& b : vehicle.breaks) {
+      utils::append_to_key(key, b.id);
+      append_tws(key, b.tws);
+      utils::append_to_key(key, b.service);
+      utils::append_to_key(key, b.description);
+      utils::append_to_key(key, b.max_load.has_value());
+      if (b.max_load.has_value()) {
+        append_amount(key, b.max_load.value());
+      }
+    }
+
+    utils::append_to_key(key, vehicle.description);
+    utils::append_to_key(key, vehicle.costs.fixed);
+    utils::append_to_key(key, vehicle.costs.per_hour);
+    utils::append_to_key(key, vehicle.costs.per_km);
+    utils::append_to_key(key, vehicle.costs.per_task_hour);
+    // Speed factor is only stored as a scaling of durations.
+    utils::append_to_key(key, vehicle.cost_wrapper.duration_factor());
+    // Use max_tasks from input if already adjusted upon solving.
+    utils::append_to_key(key,
+                         (v < _input_max_tasks.size()) ? _input_max_tasks[v]
+                                                       : vehicle.max_tasks);
+    utils::append_to_key(key, vehicle.max_travel_time);
+    utils::append_to_key(key, vehicle.max_distance);
+    utils::append_to_key(key, vehicle.type_str);
+
+    utils::append_to_key(key, vehicle.steps.size());
+    for (const auto& step : vehicle.steps) {
+      utils::append_to_key(key, step.id);
+      utils::append_to_key(key, step.type);
+      utils::append_to_key(key, step.job_type);
+      utils::append_to_key(key, step.forced_service.at);
+      utils::append_to_key(key, step.forced_service.after);
+      utils::append_to_key(key, step.forced_service.before);
+    }
+  }
+
+  // Only custom matrices are part of the input, other matrices are
+  // retrieved from routing engines or filled internally.
+  append_matrices(key, _durations_matrices, [this](const auto& profile) {
+    return !_routed_durations_profiles.contains(profile);
+  });
+  append_matrices(key, _distances_matrices, [this](const auto& profile) {
+    return _custom_distances_profiles.contains(profile);
+  });
+  append_matrices(key, _costs_matrices, [](const auto&) { return true; });
+
+  return key;
+}
+
 std::unique_ptr<VRP> Input::get_problem() const {
   if (_has_TW) {
     return std::make_unique<VRPTW>(*this);
@@ -1198,118 +2076,314 @@ std::unique_ptr<VRP> Input::get_problem() const {
   return std::make_unique<CVRP>(*this);
 }
 
-Solution Input::solve(const unsigned exploration_level,
-                      const unsigned nb_thread,
-                      const Timeout& timeout) {
-  return solve(utils::get_nb_searches(exploration_level),
-               utils::get_depth(exploration_level),
-               nb_thread,
-               timeout);
+void Input::add_routes_geometry(Solution& sol,
+                                unsigned nb_thread,
+                                const TimePoint& end_solving) const {
+  std::vector<std::jthread> threads;
+  threads.reserve(sol.routes.size());
+  std::exception_ptr ep = nullptr;
+  std::mutex ep_m;
+  std::counting_semaphore<MAX_ROUTING_THREADS> semaphore(
+    std::min(MAX_ROUTING_THREADS, nb_thread));
+
+  auto run_routing = [this, &semaphore, &sol, &ep, &ep_m](std::size_t i) {
+    semaphore.acquire();
+    try {
+      auto& route = sol.routes[i];
+      const auto& profile = route.profile;
+      auto rw = std::ranges::find_if(_routing_wrappers, [&](const auto& wr) {
+        return wr->profile == profile;
+      });
+      if (rw == _routing_wrappers.end()) {
+        throw InputException(
+          "Route geometry request with non-routable profile " + profile +
+          ".");
+      }
+      (*rw)->add_geometry(route);
+    } catch (...) {
+      const std::scoped_lock<std::mutex> lock(ep_m);
+      ep = std::current_exception();
+    }
+    semaphore.release();
+  };
+
+  for (std::size_t i = 0; i < sol.routes.size(); ++i) {
+    threads.emplace_back(run_routing, i);
+  }
+
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  if (ep != nullptr) {
+    std::rethrow_exception(ep);
+  }
+
+  const auto end_routing = std::chrono::high_resolution_clock::now();
+  auto routing = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   end_routing - end_solving)
+                   .count();
+
+  sol.summary.computing_times.routing = routing;
 }
 
-Solution Input::solve(const unsigned nb_searches,
-                      const unsigned depth,
-                      const unsigned nb_thread,
-                      const Timeout& timeout) {
+void Input::prepare(unsigned nb_thread) {
+  if (_prepared) {
+    return;
+  }
+
+  if (_matrices_initialized) {
+    // Preparing again after changes.
+    _start_loading = std::chrono::high_resolution_clock::now();
+  }
+
   run_basic_checks();
 
-  if (_has_initial_routes) {
+  restore_jobs();
+  if (_aggregate_jobs) {
+    aggregate_jobs();
+  }
+
+  if (has_initial_routes()) {
     set_vehicle_steps_ranks();
   }
 
   set_jobs_durations_per_vehicle_type();
 
+  if (!_matrices_initialized) {
+    init_matrices();
+    _matrices_initialized = true;
+  } else {
+    update_matrices();
+  }
   set_matrices(nb_thread);
   set_vehicles_costs();
+  set_vehicle_classes();
 
   // Fill vehicle/job compatibility matrices.
-  set_skills_compatibility();
-  set_extra_compatibility();
-  set_vehicles_compatibility();
+  set_skills_compatibility(nb_thread);
+  set_extra_compatibility(nb_thread);
+  set_vehicles_compatibility(nb_thread);
 
-  set_jobs_vehicles_evals();
+  set_jobs_vehicles_evals(nb_thread);
+  set_jobs_neighbours(nb_thread);
 
   // Add implicit max_tasks constraints derived from capacity and
   // TW. Note: rely on set_extra_compatibility being run previously to
   // catch wrong breaks definition.
   set_vehicles_max_tasks();
 
-  // Load relevant problem.
-  auto instance = get_problem();
   _end_loading = std::chrono::high_resolution_clock::now();
+  _prepared = true;
+}
 
-  auto loading = std::chrono::duration_cast<std::chrono::milliseconds>(
-    _end_loading - _start_loading);
-
+Timeout Input::get_remaining_time(const Timeout& timeout) const {
   // Decide time allocated for solving, 0 means only heuristics will
   // be applied.
-  Timeout solve_time;
-  if (timeout.has_value()) {
-    solve_time = (loading <= timeout.value()) ? (timeout.value() - loading)
-                                              : std::chrono::milliseconds(0);
+  if (!timeout.has_value()) {
+    return timeout;
   }
 
+  const auto loading = std::chrono::duration_cast<std::chrono::milliseconds>(
+    _end_loading - _start_loading);
+  return (loading <= timeout.value()) ? (timeout.value() - loading)
+                                      : std::chrono::milliseconds(0);
+}
+
+Solution Input::solve(const unsigned exploration_level,
+                      const unsigned nb_thread,
+                      const Timeout& timeout) {
+  return solve(utils::get_nb_searches(exploration_level),
+               utils::get_depth(exploration_level),
+               nb_thread,
+               timeout);
+}
+
+Solution Input::solve(const unsigned nb_searches,
+                      const unsigned depth,
+                      const unsigned nb_thread,
+                      const Timeout& timeout) {
+  const bool was_prepared = _prepared;
+  prepare(nb_thread);
+
+  const auto solve_time =
+    was_prepared ? timeout : get_remaining_time(timeout);
+
+  auto sol = solve_prepared(nb_searches, depth, nb_thread, solve_time);
+
+  set_previous_steps(sol);
+
+  return sol;
+}
+
+Solution Input::solve_auto(const unsigned nb_thread, const Timeout& timeout) {
+  const bool was_prepared = _prepared;
+  prepare(nb_thread);
+
+  const auto solve_time =
+    was_prepared ? timeout : get_remaining_time(timeout);
+
+  // Number of searches and depth have to be independent from timing
+  // and threads for deterministic solving.
+  const bool deterministic = _max_moves.has_value();
+  auto exploration =
+    utils::get_auto_exploration(jobs.size(),
+                                vehicles.size(),
+                                deterministic ? 1 : nb_thread,
+                                deterministic ? Timeout() : solve_time);
+  if (deterministic) {
+    exploration.ls_nb_threads =
+      utils::get_ls_nb_threads(exploration.nb_searches, nb_thread);
+  }
+
+  auto sol = solve_prepared(exploration, nb_thread, solve_time);
+  sol.summary.exploration = exploration;
+
+  set_previous_steps(sol);
+
+  return sol;
+}
+
+Solution Input::solve_prepared(const unsigned exploration_level,
+                               const unsigned nb_thread,
+                               const Timeout& timeout) const {
+  return solve_prepared(utils::get_nb_searches(exploration_level),
+                        utils::get_depth(exploration_level),
+                        nb_thread,
+                        timeout);
+}
+
+Solution Input::solve_prepared(const unsigned nb_searches,
+                               const unsigned depth,
+                               const unsigned nb_thread,
+                               const Timeout& timeout) const {
+  return solve_prepared({nb_searches,
+                         depth,
+                         utils::get_ls_nb_threads(nb_searches, nb_thread)},
+                        nb_thread,
+                        timeout);
+}
+
+Solution Input::solve_prepared(const Exploration& exploration,
+                               const unsigned nb_thread,
+                               const Timeout& timeout) const {
+  if (!_prepared) {
+    throw InputException("Solving input that has not been prepared.");
+  }
+  const auto start_solving = std::chrono::high_resolution_clock::now();
+
   // Solve.
-  auto sol = instance->solve(nb_searches, depth, nb_thread, solve_time);
+  auto sol = get_problem()->solve(exploration.nb_searches,
+                                  exploration.depth,
+                                  nb_thread,
+                                  exploration.ls_nb_threads,
+                                  timeout);
 
   // Update timing info.
-  sol.summary.computing_times.loading = loading.count();
+  sol.summary.computing_times.loading =
+    std::chrono::duration_cast<std::chrono::milliseconds>(_end_loading -
+                                                          _start_loading)
+      .count();
 
-  _end_solving = std::chrono::high_resolution_clock::now();
+  const auto end_solving = std::chrono::high_resolution_clock::now();
   sol.summary.computing_times.solving =
-    std::chrono::duration_cast<std::chrono::milliseconds>(_end_solving -
-                                                          _end_loading)
+    std::chrono::duration_cast<std::chrono::milliseconds>(end_solving -
+                                                          start_solving)
       .count();
 
   if (_geometry) {
-    std::vector<std::jthread> threads;
-    threads.reserve(sol.routes.size());
-    std::exception_ptr ep = nullptr;
-    std::mutex ep_m;
-    std::counting_semaphore<MAX_ROUTING_THREADS> semaphore(
-      std::min(MAX_ROUTING_THREADS, nb_thread));
-
-    auto run_routing = [this, &semaphore, &sol, &ep, &ep_m](std::size_t i) {
-      semaphore.acquire();
-      try {
-        auto& route = sol.routes[i];
-        const auto& profile = route.profile;
-        auto rw = std::ranges::find_if(_routing_wrappers, [&](const auto& wr) {
-          return wr->profile == profile;
-        });
-        if (rw == _routing_wrappers.end()) {
-          throw InputException(
-            "Route geometry request with non-routable profile " + profile +
-            ".");
-        }
-        (*rw)->add_geometry(route);
-      } catch (...) {
-        const std::scoped_lock<std::mutex> lock(ep_m);
-        ep = std::current_exception();
-      }
-      semaphore.release();
-    };
+    add_routes_geometry(sol, nb_thread, end_solving);
+  }
 
-    for (std::size_t i = 0; i < sol.routes.size(); ++i) {
-      threads.emplace_back(run_routing, i);
+  return sol;
+}
+
+void Input::set_previous_steps(const Solution& sol) {
+  _previous_steps = std::vector<std::vector<VehicleStep>>(vehicles.size());
+  _updated_tasks.clear();
+
+  // Solution routes are ordered by vehicle rank, skipping empty ones.
+  auto route = sol.routes.cbegin();
+  for (Index v = 0; v < vehicles.size() && route != sol.routes.cend(); ++v) {
+    if (route->vehicle != vehicles[v].id) {
+      continue;
+    }
+
+    for (const auto& step : route->steps) {
+      if (step.step_type == STEP_TYPE::JOB) {
+        assert(step.job_type.has_value());
+        _previous_steps[v].emplace_back(step.job_type.value(),
+                                        step.id,
+                                        ForcedService());
+      }
     }
+    ++route;
+  }
+}
 
-    for (auto& t : threads) {
-      t.join();
+Solution Input::reoptimize(const unsigned depth,
+                           const unsigned nb_thread,
+                           const Timeout& timeout) {
+  if (_previous_steps.size() != vehicles.size()) {
+    throw InputException("No previous solution to reoptimize.");
+  }
+
+  // Start from previous routes without removed or updated tasks,
+  // user-provided vehicle steps being left untouched.
+  std::unordered_set<Index> affected_vehicles;
+  std::vector<std::vector<VehicleStep>> reoptimized_steps(vehicles.size());
+  for (Index v = 0; v < vehicles.size(); ++v) {
+    auto& steps = reoptimized_steps[v];
+    steps.reserve(_previous_steps[v].size());
+
+    for (const auto& step : _previous_steps[v]) {
+      if (_updated_tasks.contains({step.job_type.value(), step.id})) {
+        affected_vehicles.insert(v);
+      } else {
+        steps.emplace_back(step.job_type.value(), step.id, ForcedService());
+      }
     }
+  }
+  _reoptimized_steps = std::move(reoptimized_steps);
+  _prepared = false;
+
+  // Later calls to prepare start from user-provided steps again.
+  const auto reset_initial_routes = [this] {
+    _reoptimized_steps.clear();
+    _prepared = false;
+  };
 
-    if (ep != nullptr) {
-      std::rethrow_exception(ep);
+  auto sol = [&] {
+    try {
+      prepare(nb_thread);
+      return get_problem()->reoptimize(depth,
+                                       nb_thread,
+                                       affected_vehicles,
+                                       get_remaining_time(timeout));
+    } catch (...) {
+      reset_initial_routes();
+      throw;
     }
+  }();
+  reset_initial_routes();
 
-    _end_routing = std::chrono::high_resolution_clock::now();
-    auto routing = std::chrono::duration_cast<std::chrono::milliseconds>(
-                     _end_routing - _end_solving)
-                     .count();
+  sol.summary.computing_times.loading =
+    std::chrono::duration_cast<std::chrono::milliseconds>(_end_loading -
+                                                          _start_loading)
+      .count();
 
-    sol.summary.computing_times.routing = routing;
+  const auto end_solving = std::chrono::high_resolution_clock::now();
+  sol.summary.computing_times.solving =
+    std::chrono::duration_cast<std::chrono::milliseconds>(end_solving -
+                                                          _end_loading)
+      .count();
+
+  if (_geometry) {
+    add_routes_geometry(sol, nb_thread, end_solving);
   }
 
+  set_previous_steps(sol);
+
   return sol;
 }
 
@@ -1317,16 +2391,20 @@ Solution Input::check(unsigned nb_thread) {
 #if USE_LIBGLPK
   run_basic_checks();
 
+  restore_jobs();
+
   set_jobs_durations_per_vehicle_type();
 
   set_vehicle_steps_ranks();
 
   constexpr bool sparse_filling = true;
+  init_matrices(sparse_filling);
   set_matrices(nb_thread, sparse_filling);
   set_vehicles_costs();
+  set_vehicle_classes();
 
   // Fill basic skills compatibility matrix.
-  set_skills_compatibility();
+  set_skills_compatibility(nb_thread);
 
   _end_loading = std::chrono::high_resolution_clock::now();
 
@@ -10,12 +10,15 @@ All rights reserved (see LICENSE).
 
 */
 
+#include <cassert>
 #include <chrono>
 #include <memory>
 #include <optional>
+#include <set>
 #include <unordered_map>
 
 #include "routing/wrapper.h"
+#include "structures/generic/bit_matrix.h"
 #include "structures/generic/matrix.h"
 #include "structures/typedefs.h"
 #include "structures/vroom/matrices.h"
@@ -53,6 +56,10 @@ private:
   bool _homogeneous_profiles{true};
   bool _homogeneous_costs{true};
   bool _geometry{false};
+  bool _aggregate_jobs{false};
+  std::optional<unsigned> _max_moves;
+  bool _adaptive_operators{false};
+  bool _ruin_and_recreate{false};
   bool _report_distances;
   bool _has_jobs{false};
   bool _has_shipments{false};
@@ -68,18 +75,68 @@ private:
     _distances_matrices;
   std::unordered_map<std::string, Matrix<UserCost>, StringHash, std::equal_to<>>
     _costs_matrices;
+  // Profiles using the durations and distances matrices stored for
+  // another profile served by the same routing data.
+  std::unordered_map<std::string, std::string, StringHash, std::equal_to<>>
+    _shared_matrices_profiles;
+  std::unordered_set<std::string, StringHash, std::equal_to<>>
+    _profiles_with_symmetric_costs;
   std::unordered_map<std::string, Cost, StringHash, std::equal_to<>>
     _max_cost_per_hour;
   Cost _cost_upper_bound{0};
   std::vector<Location> _locations;
   std::unordered_map<Location, Index> _locations_to_index;
   std::unordered_set<Location> _locations_used_several_times;
-  std::vector<std::vector<unsigned char>> _vehicle_to_job_compatibility;
-  std::vector<std::vector<bool>> _vehicle_to_vehicle_compatibility;
+  BitMatrix _vehicle_to_job_compatibility;
+  BitMatrix _vehicle_to_vehicle_compatibility;
   std::unordered_set<Index> _matrices_used_index;
   Index _max_matrices_used_index{0};
   bool _all_locations_have_coords{true};
-  std::vector<std::vector<Eval>> _jobs_vehicles_evals;
+  // Equivalent vehicles share the same class, _vehicle_classes[v]
+  // being the class rank for vehicle at rank v and
+  // _classes_representative[c] the first vehicle rank in class c.
+  std::vector<Index> _vehicle_classes;
+  std::vector<Index> _classes_representative;
+  // Evaluations stored per job and vehicle class.
+  Matrix<Eval> _jobs_vehicles_evals;
+  // Granular neighbourhoods. Vehicles with same profile and variable
+  // costs share the same cost profile, _vehicle_cost_profiles[v]
+  // being the profile rank for vehicle at rank v.
+  // _jobs_neighbours[p][j] holds the sorted ranks of jobs that are
+  // among the _nb_neighbours closest to job at rank j, or the other
+  // way around, for cost profile p.
+  std::optional<unsigned> _nb_neighbours;
+  std::vector<Index> _vehicle_cost_profiles;
+  std::vector<std::vector<std::vector<Index>>> _jobs_neighbours;
+
+  // Stored upon solving for later reoptimization: job steps in last
+  // solution for each vehicle and tasks removed or updated since.
+  std::vector<std::vector<VehicleStep>> _previous_steps;
+  std::set<std::pair<JOB_TYPE, Id>> _updated_tasks;
+  // Previous routes without removed or updated tasks, used as initial
+  // routes instead of vehicle steps only while reoptimizing.
+  std::vector<std::vector<VehicleStep>> _reoptimized_steps;
+  // Vehicle max_tasks values prior to adjustment in
+  // set_vehicles_max_tasks.
+  std::vector<std::size_t> _input_max_tasks;
+  // Matrices retrieved from routing engines and number of locations
+  // at the time.
+  std::unordered_set<std::string, StringHash, std::equal_to<>>
+    _routed_durations_profiles;
+  std::unordered_set<std::string, StringHash, std::equal_to<>>
+    _routed_distances_profiles;
+  std::size_t _nb_routed_locations{0};
+  // Custom distances matrices, as opposed to routed ones or zeros
+  // filled internally.
+  std::unordered_set<std::string, StringHash, std::equal_to<>>
+    _custom_distances_profiles;
+  bool _matrices_initialized{false};
+  // Set once all setup steps have been run, reset upon any change.
+  bool _prepared{false};
+  // Jobs as provided in input while co-located jobs are merged, and
+  // ranks in _unaggregated_jobs of the jobs merged into each job.
+  std::vector<Job> _unaggregated_jobs;
+  std::vector<std::vector<Index>> _aggregated_ranks;
 
   // Default vehicle type is NO_TYPE, related to the fact that we do
   // not allow empty types as keys for jobs.
@@ -102,25 +159,55 @@ private:
   void check_amount_size(const Amount& amount);
   void check_job(Job& job);
 
+  // Erase jobs with ranks in [first_rank, last_rank).
+  void set_job_id_maps();
+  void erase_jobs(Index first_rank, Index last_rank);
+  void aggregate_jobs();
+  void restore_jobs();
+  Index get_job_rank(JOB_TYPE type, Id id) const;
+
   void run_basic_checks() const;
 
   UserCost check_cost_bound(const Matrix<UserCost>& matrix) const;
 
-  void set_skills_compatibility();
-  void set_extra_compatibility();
-  void set_vehicles_compatibility();
+  void set_vehicle_classes();
+  void copy_compatibility_from_representatives();
+  void set_skills_compatibility(unsigned nb_thread);
+  void set_extra_compatibility(unsigned nb_thread);
+  void set_vehicles_compatibility(unsigned nb_thread);
   void set_vehicles_costs();
   void set_vehicles_max_tasks();
-  void set_jobs_vehicles_evals();
+  void set_jobs_vehicles_evals(unsigned nb_thread);
+  void set_jobs_neighbours(unsigned nb_thread);
+  void set_durations_per_vehicle_type(Job& job) const;
   void set_jobs_durations_per_vehicle_type();
   void set_vehicle_steps_ranks();
   void init_missing_matrices(const std::string& profile);
 
+  const std::string& matrices_profile(const std::string& profile) const;
+
+  void set_shared_matrices_profiles();
+
   routing::Matrices get_matrices_by_profile(const std::string& profile,
-                                            bool sparse_filling);
+                                            bool sparse_filling,
+                                            unsigned nb_thread);
+
+  void init_matrices(bool sparse_filling = false);
+
+  // Adjust matrices to changes since last preparation.
+  void update_matrices();
 
   void set_matrices(unsigned nb_thread, bool sparse_filling = false);
 
+  void add_routes_geometry(Solution& sol,
+                           unsigned nb_thread,
+                           const TimePoint& end_solving) const;
+
+  void set_previous_steps(const Solution& sol);
+
+  // Time left from timeout after loading.
+  Timeout get_remaining_time(const Timeout& timeout) const;
+
   void add_routing_wrapper(const std::string& profile);
 
 public:
@@ -146,12 +233,42 @@ public:
 
   void set_geometry(bool geometry);
 
+  // Merge compatible single jobs sharing a location into one job upon
+  // solving. They are reported separately in solution.
+  void set_jobs_aggregation(bool aggregate);
+
+  // If set, each search stops after applying max_moves local search
+  // moves and timeouts are ignored, so that solving is reproducible
+  // whatever the number of threads.
+  void set_max_moves(const std::optional<unsigned>& max_moves);
+
+  // If set, inter-route local search moves are only tried when they
+  // create an edge between a job and one of its nb_neighbours closest
+  // jobs.
+  void set_granularity(const std::optional<unsigned>& nb_neighbours);
+
+  // If set, local search skips operators that recently provided no
+  // applied move, enabling them all again periodically.
+  void set_adaptive_operators(bool adaptive);
+
+  // If set, searches with a timeout or a moves budget spend it on
+  // ruin and recreate iterations after their first descent.
+  void set_ruin_and_recreate(bool ruin_and_recreate);
+
   void add_job(const Job& job);
 
   void add_shipment(const Job& pickup, const Job& delivery);
 
   void add_vehicle(const Vehicle& vehicle);
 
+  // Changes to tasks prior to calling reoptimize, new tasks being
+  // added using add_job and add_shipment.
+  void remove_job(Id id);
+
+  void remove_shipment(Id pickup_id);
+
+  void update_tws(JOB_TYPE type, Id id, const std::vector<TimeWindow>& tws);
+
   void set_durations_matrix(const std::string& profile,
                             Matrix<UserDuration>&& m);
 
@@ -168,6 +285,18 @@ public:
     return _apply_TSPFix;
   }
 
+  const std::optional<unsigned>& max_moves() const {
+    return _max_moves;
+  }
+
+  bool adaptive_operators() const {
+    return _adaptive_operators;
+  }
+
+  bool ruin_and_recreate() const {
+    return _ruin_and_recreate;
+  }
+
   bool is_used_several_times(const Location& location) const;
 
   bool has_skills() const;
@@ -186,7 +315,34 @@ public:
     return _all_locations_have_coords;
   }
 
-  const std::vector<std::vector<Eval>>& jobs_vehicles_evals() const {
+  Index vehicle_class(Index v) const {
+    return _vehicle_classes[v];
+  }
+
+  std::size_t nb_vehicle_classes() const {
+    return _classes_representative.size();
+  }
+
+  Index class_representative(Index c) const {
+    return _classes_representative[c];
+  }
+
+  bool has_granularity() const {
+    return _nb_neighbours.has_value();
+  }
+
+  // Sorted ranks of jobs that are neighbours of job at rank j from
+  // the point of view of vehicle at rank v. Only available with
+  // granular neighbourhoods.
+  const std::vector<Index>& job_neighbours(Index v, Index j) const {
+    assert(_nb_neighbours.has_value());
+    return _jobs_neighbours[_vehicle_cost_profiles[v]][j];
+  }
+
+  // jobs_vehicles_evals()[j][c] evaluates fetching job at rank j in an
+  // empty route for vehicles in class c, or holds the cost upper
+  // bound if those vehicles are not compatible with that job.
+  const Matrix<Eval>& jobs_vehicles_evals() const {
     return _jobs_vehicles_evals;
   }
 
@@ -198,8 +354,36 @@ public:
 
   bool has_initial_routes() const;
 
+  // Initial route for vehicle at rank v: previous route while
+  // reoptimizing, user-provided steps otherwise.
+  const std::vector<VehicleStep>& initial_steps(Index v) const {
+    return _reoptimized_steps.empty() ? vehicles[v].steps
+                                      : _reoptimized_steps[v];
+  }
+
+  bool is_aggregated(Index j) const {
+    return !_aggregated_ranks.empty() && !_aggregated_ranks[j].empty();
+  }
+
+  // Ranks of the jobs merged into job with rank j, in service order,
+  // to be used with unaggregated_job.
+  const std::vector<Index>& aggregated_ranks(Index j) const {
+    assert(is_aggregated(j));
+    return _aggregated_ranks[j];
+  }
+
+  const Job& unaggregated_job(Index rank) const {
+    return _unaggregated_jobs[rank];
+  }
+
+  // Serialization of all input data relevant to solving: tasks,
+  // vehicles, custom matrices, routing setup and solving flags.
+  // Identical inputs yield the same key regardless of skills or
+  // per-type durations ordering, distinct inputs yield distinct keys.
+  std::string canonical_key() const;
+
   bool vehicle_ok_with_job(size_t v_index, size_t j_index) const {
-    return static_cast<bool>(_vehicle_to_job_compatibility[v_index][j_index]);
+    return _vehicle_to_job_compatibility(v_index, j_index);
   }
 
   // Returns true iff both vehicles have common job candidates.
@@ -216,6 +400,40 @@ public:
                  unsigned nb_thread,
                  const Timeout& timeout = Timeout());
 
+  // Choose number of searches, depth and threads split from instance
+  // size and remaining time after loading, reported in solution
+  // summary.
+  Solution solve_auto(unsigned nb_thread, const Timeout& timeout = Timeout());
+
+  // Run all setup steps (matrices, costs, compatibility, evaluations
+  // and bounds) if not already done. A prepared Input is not modified
+  // by solve_prepared, so it can be solved concurrently, e.g. with
+  // different exploration levels or timeouts.
+  void prepare(unsigned nb_thread);
+
+  Solution solve_prepared(unsigned nb_searches,
+                          unsigned depth,
+                          unsigned nb_thread,
+                          const Timeout& timeout = Timeout()) const;
+
+  Solution solve_prepared(unsigned exploration_level,
+                          unsigned nb_thread,
+                          const Timeout& timeout = Timeout()) const;
+
+  // Use exploration.ls_nb_threads threads within each search, other
+  // threads run searches concurrently.
+  Solution solve_prepared(const Exploration& exploration,
+                          unsigned nb_thread,
+                          const Timeout& timeout = Timeout()) const;
+
+  // Solve again after changes to tasks, starting from previous
+  // solution. Matrices are only computed again for new locations. New
+  // tasks and tasks with updated time windows are inserted, then a
+  // local search is run starting with affected routes.
+  Solution reoptimize(unsigned depth,
+                      unsigned nb_thread,
+                      const Timeout& timeout = Timeout());
+
   Solution check(unsigned nb_thread);
 };
 
@@ -29,7 +29,7 @@ struct Job {
   const Amount pickup;
   const Skills skills;
   const Priority priority;
-  const std::vector<TimeWindow> tws;
+  std::vector<TimeWindow> tws;
   const std::string description;
   const TypeToDurationMap setup_per_type;
   const TypeToDurationMap service_per_type;
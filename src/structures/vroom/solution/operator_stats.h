@@ -0,0 +1,55 @@
+#ifndef OPERATOR_STATS_H
+#define OPERATOR_STATS_H
+
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include <array>
+#include <chrono>
+
+#include "structures/typedefs.h"
+
+namespace vroom {
+
+struct OperatorStats {
+  // Number of route pairs the operator has been run on.
+  unsigned evaluations{0};
+  // Number of valid moves improving on best known move for a pair.
+  unsigned valid_moves{0};
+  unsigned applied_moves{0};
+  std::chrono::nanoseconds time{0};
+
+  void add_run(std::size_t nb_pairs, const TimePoint& start) {
+    evaluations += nb_pairs;
+    time += std::chrono::high_resolution_clock::now() - start;
+  }
+
+  OperatorStats& operator+=(const OperatorStats& rhs) {
+    evaluations += rhs.evaluations;
+    valid_moves += rhs.valid_moves;
+    applied_moves += rhs.applied_moves;
+    time += rhs.time;
+    return *this;
+  }
+};
+
+// Statistics indexed by OperatorName.
+using OperatorsStats = std::array<OperatorStats, OperatorName::MAX>;
+
+inline OperatorsStats& operator+=(OperatorsStats& lhs,
+                                  const OperatorsStats& rhs) {
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    lhs[i] += rhs[i];
+  }
+  return lhs;
+}
+
+} // namespace vroom
+
+#endif
@@ -10,9 +10,12 @@ All rights reserved (see LICENSE).
 
 */
 
+#include <optional>
+
 #include "structures/typedefs.h"
 #include "structures/vroom/amount.h"
 #include "structures/vroom/solution/computing_times.h"
+#include "structures/vroom/solution/operator_stats.h"
 #include "structures/vroom/solution/violations.h"
 
 namespace vroom {
@@ -31,6 +34,10 @@ struct Summary {
   UserDuration waiting_time{0};
   UserDistance distance{0};
   ComputingTimes computing_times;
+  // Only set when exploration is chosen automatically.
+  std::optional<Exploration> exploration;
+  // Local search operators statistics, summed over all searches.
+  OperatorsStats operators_stats{};
 
   Violations violations{0, 0};
 
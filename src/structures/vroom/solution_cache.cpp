@@ -0,0 +1,96 @@
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include <cassert>
+#include <limits>
+
+#include "structures/vroom/solution_cache.h"
+#include "utils/helpers.h"
+
+namespace vroom {
+
+SolutionCache::SolutionCache(std::size_t capacity) : _capacity(capacity) {
+  assert(_capacity > 0);
+}
+
+std::string SolutionCache::get_key(const Input& input,
+                                   unsigned nb_searches,
+                                   unsigned depth,
+                                   const Timeout& timeout) {
+  std::string key = input.canonical_key();
+  utils::append_to_key(key, nb_searches);
+  utils::append_to_key(key, depth);
+
+  constexpr std::chrono::milliseconds::rep ms_per_second = 1000;
+  const auto timeout_bucket =
+    timeout.has_value()
+      ? (timeout.value().count() + ms_per_second - 1) / ms_per_second
+      : std::numeric_limits<std::chrono::milliseconds::rep>::max();
+  utils::append_to_key(key, timeout_bucket);
+
+  return key;
+}
+
+std::optional<Solution> SolutionCache::find(const std::string& key) {
+  const std::scoped_lock<std::mutex> lock(_mutex);
+
+  const auto search = _key_to_entry.find(key);
+  if (search == _key_to_entry.end()) {
+    return std::nullopt;
+  }
+
+  _entries.splice(_entries.begin(), _entries, search->second);
+  return search->second->second;
+}
+
+void SolutionCache::insert(const std::string& key, const Solution& solution) {
+  const std::scoped_lock<std::mutex> lock(_mutex);
+
+  if (const auto search = _key_to_entry.find(key);
+      search != _key_to_entry.end()) {
+    // Solution objects are not assignable. Map entry goes first as
+    // its key is a view on the list entry.
+    const auto entry = search->second;
+    _key_to_entry.erase(search);
+    _entries.erase(entry);
+  }
+
+  _entries.emplace_front(key, solution);
+  _key_to_entry.emplace(_entries.front().first, _entries.begin());
+
+  if (_entries.size() > _capacity) {
+    _key_to_entry.erase(_entries.back().first);
+    _entries.pop_back();
+  }
+}
+
+Solution SolutionCache::solve(Input& input,
+                              unsigned nb_searches,
+                              unsigned depth,
+                              unsigned nb_thread,
+                              const Timeout& timeout) {
+  const auto key = get_key(input, nb_searches, depth, timeout);
+
+  if (auto cached = find(key); cached.has_value()) {
+    cached.value().summary.computing_times = ComputingTimes();
+    return std::move(cached.value());
+  }
+
+  auto sol = input.solve(nb_searches, depth, nb_thread, timeout);
+  insert(key, sol);
+
+  return sol;
+}
+
+std::size_t SolutionCache::size() {
+  const std::scoped_lock<std::mutex> lock(_mutex);
+  return _entries.size();
+}
+
+} // namespace vroom
@@ -0,0 +1,69 @@
+#ifndef SOLUTION_CACHE_H
+#define SOLUTION_CACHE_H
+
+/*
+
+This file is part of VROOM.
+
+Copyright (c) 2015-2025, Julien Coupey.
+All rights reserved (see LICENSE).
+
+*/
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "structures/typedefs.h"
+#include "structures/vroom/input/input.h"
+#include "structures/vroom/solution/solution.h"
+
+namespace vroom {
+
+// Thread-safe LRU cache of solutions, e.g. for long-running processes
+// solving the same instances repeatedly. Keys combine the canonical
+// input key with solving parameters and are stored in full, so entries
+// use memory in the order of their input size, custom matrices
+// included.
+class SolutionCache {
+private:
+  using Entries = std::list<std::pair<std::string, Solution>>;
+
+  const std::size_t _capacity;
+  std::mutex _mutex;
+  // Most recently used entries first, indexed by views on their keys.
+  Entries _entries;
+  std::unordered_map<std::string_view, Entries::iterator> _key_to_entry;
+
+public:
+  explicit SolutionCache(std::size_t capacity);
+
+  // Timeouts are rounded up to the second so that close values share
+  // the same entry.
+  static std::string get_key(const Input& input,
+                             unsigned nb_searches,
+                             unsigned depth,
+                             const Timeout& timeout = Timeout());
+
+  std::optional<Solution> find(const std::string& key);
+
+  void insert(const std::string& key, const Solution& solution);
+
+  // Return cached solution if any, otherwise solve input and store
+  // result. Cached solutions are returned with zero computing times as
+  // no loading, solving or routing happened.
+  Solution solve(Input& input,
+                 unsigned nb_searches,
+                 unsigned depth,
+                 unsigned nb_thread,
+                 const Timeout& timeout = Timeout());
+
+  std::size_t size();
+};
+
+} // namespace vroom
+
+#endif
@@ -70,6 +70,35 @@ struct SolutionIndicators {
                                                 rhs.eval.distance,
                                                 rhs.routes_hash);
   }
+
+  // Equivalence as defined by operator<.
+  friend bool operator==(const SolutionIndicators& lhs,
+                         const SolutionIndicators& rhs) {
+    return std::tie(lhs.priority_sum,
+                    lhs.assigned,
+                    lhs.eval.cost,
+                    lhs.used_vehicles,
+                    lhs.eval.duration,
+                    lhs.eval.distance,
+                    lhs.routes_hash) == std::tie(rhs.priority_sum,
+                                                 rhs.assigned,
+                                                 rhs.eval.cost,
+                                                 rhs.used_vehicles,
+                                                 rhs.eval.duration,
+                                                 rhs.eval.distance,
+                                                 rhs.routes_hash);
+  }
+
+  std::size_t hash() const {
+    std::size_t seed = routes_hash;
+    hash_combine(seed, priority_sum);
+    hash_combine(seed, assigned);
+    hash_combine(seed, eval.cost);
+    hash_combine(seed, used_vehicles);
+    hash_combine(seed, eval.duration);
+    hash_combine(seed, eval.distance);
+    return seed;
+  }
 };
 
 } // namespace vroom::utils
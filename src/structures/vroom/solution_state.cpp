@@ -18,11 +18,11 @@ namespace vroom::utils {
 SolutionState::SolutionState(const Input& input)
   : _input(input),
     _nb_vehicles(_input.vehicles.size()),
-    fwd_evals(_nb_vehicles, std::vector<std::vector<Eval>>(_nb_vehicles)),
-    bwd_evals(_nb_vehicles, std::vector<std::vector<Eval>>(_nb_vehicles)),
-    service_evals(_nb_vehicles, std::vector<std::vector<Eval>>(_nb_vehicles)),
-    fwd_setup_evals(_nb_vehicles, std::vector<std::vector<Eval>>(_nb_vehicles)),
-    bwd_setup_evals(_nb_vehicles, std::vector<std::vector<Eval>>(_nb_vehicles)),
+    _nb_vehicle_classes(_input.nb_vehicle_classes()),
+    _routes(_nb_vehicles),
+    _class_evals(_nb_vehicles, std::vector<ClassEvals>(_nb_vehicle_classes)),
+    _class_evals_valid(_nb_vehicles * _nb_vehicle_classes),
+    _class_evals_mutexes(_nb_vehicles),
     fwd_skill_rank(_nb_vehicles, std::vector<Index>(_nb_vehicles)),
     bwd_skill_rank(_nb_vehicles, std::vector<Index>(_nb_vehicles)),
     fwd_priority(_nb_vehicles),
@@ -34,18 +34,15 @@ SolutionState::SolutionState(const Input& input)
     pd_gains(_nb_vehicles),
     matching_delivery_rank(_nb_vehicles),
     matching_pickup_rank(_nb_vehicles),
-    cheapest_job_rank_in_routes_from(_nb_vehicles,
-                                     std::vector<std::vector<Index>>(
-                                       _nb_vehicles)),
-    cheapest_job_rank_in_routes_to(_nb_vehicles,
-                                   std::vector<std::vector<Index>>(
-                                     _nb_vehicles)),
     insertion_ranks_begin(_nb_vehicles),
     insertion_ranks_end(_nb_vehicles),
     weak_insertion_ranks_begin(_nb_vehicles),
     weak_insertion_ranks_end(_nb_vehicles),
     route_evals(_nb_vehicles),
-    route_bbox(_nb_vehicles, BBox()) {
+    route_bbox(_nb_vehicles, BBox()),
+    route_versions(_nb_vehicles, 0),
+    job_routes(_input.jobs.size()),
+    job_ranks(_input.jobs.size()) {
 }
 
 void SolutionState::setup(const RawRoute& r) {
@@ -82,56 +79,54 @@ void SolutionState::setup(const std::vector<Route>& sol) {
 
 void SolutionState::update_costs(const RawRoute& raw_route) {
   const auto v = raw_route.v_rank;
-  const auto& route = raw_route.route;
+  _routes[v] = raw_route.route;
+  ++route_versions[v];
+
+  for (Index i = 0; i < _routes[v].size(); ++i) {
+    job_routes[_routes[v][i]] = v;
+    job_ranks[_routes[v][i]] = i;
+  }
 
-  fwd_evals[v] =
-    std::vector<std::vector<Eval>>(_nb_vehicles,
-                                   std::vector<Eval>(route.size()));
-  bwd_evals[v] =
-    std::vector<std::vector<Eval>>(_nb_vehicles,
-                                   std::vector<Eval>(route.size()));
+  for (Index c = 0; c < _nb_vehicle_classes; ++c) {
+    _class_evals_valid[v * _nb_vehicle_classes + c].store(false);
+  }
+}
 
-  fwd_setup_evals[v] =
-    std::vector<std::vector<Eval>>(_nb_vehicles,
-                                   std::vector<Eval>(route.size()));
-  bwd_setup_evals[v] =
-    std::vector<std::vector<Eval>>(_nb_vehicles,
-                                   std::vector<Eval>(route.size()));
+void SolutionState::set_class_evals(Index v, Index c) const {
+  const auto& route = _routes[v];
+  auto& evals = _class_evals[v][c];
 
-  service_evals[v] =
-    std::vector<std::vector<Eval>>(_nb_vehicles,
-                                   std::vector<Eval>(route.size()));
+  evals.fwd.resize(route.size());
+  evals.bwd.resize(route.size());
+  evals.service.resize(route.size());
+  evals.fwd_setup.resize(route.size());
+  evals.bwd_setup.resize(route.size());
 
   if (route.empty()) {
     return;
   }
 
+  const auto& vehicle = _input.vehicles[_input.class_representative(c)];
+
   // Handle evals for first job.
   const auto& first_job = _input.jobs[route[0]];
   const auto first_index = first_job.index();
   const auto& last_job = _input.jobs[route.back()];
   const auto last_index = last_job.index();
 
-  for (Index v_rank = 0; v_rank < _nb_vehicles; ++v_rank) {
-    fwd_evals[v][v_rank][0] = Eval();
-    bwd_evals[v][v_rank][0] = Eval();
+  evals.fwd[0] = Eval();
+  evals.bwd[0] = Eval();
+  evals.service[0] = vehicle.task_eval(first_job.services[vehicle.type]);
 
-    const auto& vehicle = _input.vehicles[v_rank];
-    const auto service_eval =
-      vehicle.task_eval(first_job.services[vehicle.type]);
+  evals.fwd_setup[0] =
+    (!vehicle.has_start() || vehicle.start.value().index() != first_index)
+      ? vehicle.task_eval(first_job.setups[vehicle.type])
+      : Eval();
 
-    service_evals[v][v_rank][0] = service_eval;
-
-    if (!vehicle.has_start() || vehicle.start.value().index() != first_index) {
-      fwd_setup_evals[v][v_rank][0] =
-        vehicle.task_eval(first_job.setups[vehicle.type]);
-    }
-
-    if (!vehicle.has_start() || vehicle.start.value().index() != last_index) {
-      bwd_setup_evals[v][v_rank].back() =
-        vehicle.task_eval(last_job.setups[vehicle.type]);
-    }
-  }
+  evals.bwd_setup.back() =
+    (!vehicle.has_start() || vehicle.start.value().index() != last_index)
+      ? vehicle.task_eval(last_job.setups[vehicle.type])
+      : Eval();
 
   for (std::size_t i = 1; i < route.size(); ++i) {
     const auto& previous_job = _input.jobs[route[i - 1]];
@@ -139,42 +134,30 @@ void SolutionState::update_costs(const RawRoute& raw_route) {
 
     const auto previous_index = previous_job.index();
     const auto current_index = current_job.index();
-    const bool apply_setup = (previous_index != current_index);
 
-    for (Index v_rank = 0; v_rank < _nb_vehicles; ++v_rank) {
-      const auto& vehicle = _input.vehicles[v_rank];
-      fwd_evals[v][v_rank][i] = fwd_evals[v][v_rank][i - 1] +
-                                vehicle.eval(previous_index, current_index);
+    evals.fwd[i] =
+      evals.fwd[i - 1] + vehicle.eval(previous_index, current_index);
+    evals.bwd[i] =
+      evals.bwd[i - 1] + vehicle.eval(current_index, previous_index);
 
-      bwd_evals[v][v_rank][i] = bwd_evals[v][v_rank][i - 1] +
-                                vehicle.eval(current_index, previous_index);
+    evals.service[i] =
+      evals.service[i - 1] +
+      vehicle.task_eval(current_job.services[vehicle.type]);
 
-      const auto service_eval =
-        vehicle.task_eval(current_job.services[vehicle.type]);
-      service_evals[v][v_rank][i] =
-        service_evals[v][v_rank][i - 1] + service_eval;
-
-      fwd_setup_evals[v][v_rank][i] = fwd_setup_evals[v][v_rank][i - 1];
-      if (apply_setup) {
-        fwd_setup_evals[v][v_rank][i] +=
-          vehicle.task_eval(current_job.setups[vehicle.type]);
-      }
+    evals.fwd_setup[i] = evals.fwd_setup[i - 1];
+    if (previous_index != current_index) {
+      evals.fwd_setup[i] += vehicle.task_eval(current_job.setups[vehicle.type]);
     }
   }
 
-  // Handling bwd_setup_evals only.
   for (std::size_t i = route.size() - 1; i > 0; --i) {
     const auto& previous_job = _input.jobs[route[i]];
     const auto& current_job = _input.jobs[route[i - 1]];
-    const bool apply_setup = (previous_job.index() != current_job.index());
-
-    for (Index v_rank = 0; v_rank < _nb_vehicles; ++v_rank) {
-      bwd_setup_evals[v][v_rank][i - 1] = bwd_setup_evals[v][v_rank][i];
-      if (apply_setup) {
-        const auto& vehicle = _input.vehicles[v_rank];
-        bwd_setup_evals[v][v_rank][i - 1] +=
-          vehicle.task_eval(current_job.setups[vehicle.type]);
-      }
+
+    evals.bwd_setup[i - 1] = evals.bwd_setup[i];
+    if (previous_job.index() != current_job.index()) {
+      evals.bwd_setup[i - 1] +=
+        vehicle.task_eval(current_job.setups[vehicle.type]);
     }
   }
 }
@@ -644,42 +627,6 @@ void SolutionState::set_insertion_ranks(const TWRoute& tw_r) {
   }
 }
 
-void SolutionState::update_cheapest_job_rank_in_routes(
-  const std::vector<Index>& route_1,
-  const std::vector<Index>& route_2,
-  Index v1,
-  Index v2) {
-  cheapest_job_rank_in_routes_from[v1][v2].assign(route_1.size(), 0);
-  cheapest_job_rank_in_routes_to[v1][v2].assign(route_1.size(), 0);
-
-  for (std::size_t r1 = 0; r1 < route_1.size(); ++r1) {
-    const Index index_r1 = _input.jobs[route_1[r1]].index();
-
-    auto min_from = std::numeric_limits<Cost>::max();
-    auto min_to = std::numeric_limits<Cost>::max();
-    Index best_from_rank = 0;
-    Index best_to_rank = 0;
-
-    const auto& vehicle = _input.vehicles[v2];
-    for (std::size_t r2 = 0; r2 < route_2.size(); ++r2) {
-      const Index index_r2 = _input.jobs[route_2[r2]].index();
-      if (const auto cost_from = vehicle.cost(index_r1, index_r2);
-          cost_from < min_from) {
-        min_from = cost_from;
-        best_from_rank = r2;
-      }
-      const auto cost_to = vehicle.cost(index_r2, index_r1);
-      if (cost_to < min_to) {
-        min_to = cost_to;
-        best_to_rank = r2;
-      }
-    }
-
-    cheapest_job_rank_in_routes_from[v1][v2][r1] = best_from_rank;
-    cheapest_job_rank_in_routes_to[v1][v2][r1] = best_to_rank;
-  }
-}
-
 void SolutionState::update_route_eval(const RawRoute& raw_route) {
   const auto v = raw_route.v_rank;
 
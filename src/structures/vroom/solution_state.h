@@ -10,6 +10,9 @@ All rights reserved (see LICENSE).
 
 */
 
+#include <atomic>
+#include <mutex>
+
 #include "structures/typedefs.h"
 #include "structures/vroom/bbox.h"
 #include "structures/vroom/input/input.h"
@@ -17,38 +20,48 @@ All rights reserved (see LICENSE).
 
 namespace vroom::utils {
 
+// Evaluations along a route, from the point of view of vehicles in a
+// given class.
+struct ClassEvals {
+  // fwd[i] stores the total cost from job at rank 0 to job at rank i.
+  // bwd[i] stores the total cost from job at rank i to job at rank 0
+  // (i.e. when *reversing* all edges).
+  std::vector<Eval> fwd;
+  std::vector<Eval> bwd;
+
+  // service[i] stores the total service cost from job at rank 0 to
+  // job at rank i (included).
+  std::vector<Eval> service;
+
+  // fwd_setup[i] stores the total setup cost from job at rank 0 to job
+  // at rank i (included). bwd_setup[i] stores the total setup cost
+  // from last job to job at rank i included, i.e. when *reversing*
+  // route.
+  std::vector<Eval> fwd_setup;
+  std::vector<Eval> bwd_setup;
+};
+
 class SolutionState {
 private:
   const Input& _input;
   const std::size_t _nb_vehicles;
+  const std::size_t _nb_vehicle_classes;
+
+  // Jobs in each route as of last update_costs call. Matching
+  // ClassEvals are only computed upon first use for a given vehicle
+  // class, buffers being reused across updates. A mutex per route
+  // guards computation for concurrent reads.
+  std::vector<std::vector<Index>> _routes;
+  mutable std::vector<std::vector<ClassEvals>> _class_evals;
+  mutable std::vector<std::atomic<bool>> _class_evals_valid;
+  mutable std::vector<std::mutex> _class_evals_mutexes;
+
+  void set_class_evals(Index v, Index c) const;
 
 public:
   // Store unassigned jobs.
   std::unordered_set<Index> unassigned;
 
-  // fwd_evals[v][new_v][i] stores the total cost from job at rank 0
-  // to job at rank i in the route for vehicle v, from the point of
-  // view of a vehicle new_v. bwd_evals[v][new_v][i] stores the total
-  // cost from job at rank i to job at rank 0 (i.e. when *reversing*
-  // all edges) in the route for vehicle v, from the point of view of
-  // a vehicle new_v.
-  std::vector<std::vector<std::vector<Eval>>> fwd_evals;
-  std::vector<std::vector<std::vector<Eval>>> bwd_evals;
-
-  // service_evals[v][new_v][i] stores the total service cost from job
-  // at rank 0 to job at rank i (included) in the route for vehicle v,
-  // from the point of view of a vehicle new_v.
-  std::vector<std::vector<std::vector<Eval>>> service_evals;
-
-  // fwd_setup_evals[v][new_v][i] stores the total setup cost from job
-  // at rank 0 to job at rank i (included) in the route for vehicle v,
-  // from the point of view of vehicle new_v.
-  // bwd_setup_evals[v][new_v][i] stores the total setup cost from
-  // last job to job at rank i included, i.e. when *reversing* route
-  // for vehicle v, from the point of view of a vehicle new_v.
-  std::vector<std::vector<std::vector<Eval>>> fwd_setup_evals;
-  std::vector<std::vector<std::vector<Eval>>> bwd_setup_evals;
-
   // fwd_skill_rank[v1][v2] stores the maximum rank r for a step in
   // route for vehicle v1 such that v2 can handle all jobs from step 0
   // to r -- excluded -- in that route. bwd_skill_rank[v1][v2] stores
@@ -94,15 +107,6 @@ public:
   std::vector<std::vector<Index>> matching_delivery_rank;
   std::vector<std::vector<Index>> matching_pickup_rank;
 
-  // cheapest_job_rank_in_routes_from[v1][v2][r1] stores the rank of
-  // job in route v2 that minimize cost (as seen from the v2
-  // perspective) from job at rank r1 in v1.
-  std::vector<std::vector<std::vector<Index>>> cheapest_job_rank_in_routes_from;
-  // cheapest_job_rank_in_routes_to[v1][v2][r1] stores the rank of job
-  // in route v2 that minimize cost (as seen from the v2 perspective)
-  // to job at rank r1 in v1.
-  std::vector<std::vector<std::vector<Index>>> cheapest_job_rank_in_routes_to;
-
   // insertion_ranks_begin[v][j] is the highest rank in route for
   // vehicle v such that inserting job at rank j strictly before
   // insertion_ranks_begin[v][j] is bound to fail based on job
@@ -135,12 +139,49 @@ public:
   // end).
   std::vector<BBox> route_bbox;
 
+  // Incremented for a route upon each update_costs call, so that data
+  // computed from a route can be reused while it is unchanged.
+  std::vector<unsigned> route_versions;
+
+  // Route and rank for each job as of last update_costs call for that
+  // route. Values are left unchanged for jobs that are removed from a
+  // route, so should be checked using is_in_route.
+  std::vector<Index> job_routes;
+  std::vector<Index> job_ranks;
+
   explicit SolutionState(const Input& input);
 
+  Index vehicle_class(Index v) const {
+    return _input.vehicle_class(v);
+  }
+
+  // Evaluations along route for vehicle v from the point of view of
+  // vehicles in class c.
+  const ClassEvals& class_evals(Index v, Index c) const {
+    auto& valid = _class_evals_valid[v * _nb_vehicle_classes + c];
+    if (!valid.load(std::memory_order_acquire)) {
+      const std::scoped_lock lock(_class_evals_mutexes[v]);
+      if (!valid.load(std::memory_order_relaxed)) {
+        set_class_evals(v, c);
+        valid.store(true, std::memory_order_release);
+      }
+    }
+    return _class_evals[v][c];
+  }
+
+  // True if job at rank j is in route for vehicle v as of last
+  // update_costs call for that route, at rank job_ranks[j].
+  bool is_in_route(Index j, Index v) const {
+    const auto rank = job_ranks[j];
+    return job_routes[j] == v && rank < _routes[v].size() &&
+           _routes[v][rank] == j;
+  }
+
   void setup(const RawRoute& r);
 
   template <class Route> void setup(const std::vector<Route>& sol);
 
+  // Invalidate evaluations from class_evals for route.
   void update_costs(const RawRoute& raw_route);
 
   void update_skills(const RawRoute& raw_route);
@@ -159,11 +200,6 @@ public:
 
   void set_pd_matching_ranks(const RawRoute& raw_route);
 
-  void update_cheapest_job_rank_in_routes(const std::vector<Index>& route_1,
-                                          const std::vector<Index>& route_2,
-                                          Index v1,
-                                          Index v2);
-
   void set_insertion_ranks(const RawRoute& r);
   void set_insertion_ranks(const TWRoute& r);
 
@@ -30,6 +30,9 @@ struct TimeWindow {
   bool is_default() const;
 
   friend bool operator<(const TimeWindow& lhs, const TimeWindow& rhs);
+
+  friend bool operator==(const TimeWindow& lhs,
+                         const TimeWindow& rhs) = default;
 };
 
 } // namespace vroom
@@ -135,10 +135,30 @@ bool Vehicle::has_same_profile(const Vehicle& other) const {
          this->cost_wrapper.has_same_variable_costs(other.cost_wrapper);
 }
 
+bool Vehicle::is_equivalent_to(const Vehicle& other) const {
+  return this->type == other.type && this->capacity == other.capacity &&
+         this->tw == other.tw && this->costs == other.costs &&
+         this->max_tasks == other.max_tasks &&
+         this->max_travel_time == other.max_travel_time &&
+         this->max_distance == other.max_distance &&
+         this->has_same_locations(other) && this->profile == other.profile &&
+         this->cost_wrapper == other.cost_wrapper &&
+         this->skills == other.skills &&
+         std::ranges::equal(this->breaks,
+                            other.breaks,
+                            [](const auto& lhs, const auto& rhs) {
+                              return lhs.has_same_constraints(rhs);
+                            });
+}
+
 bool Vehicle::cost_based_on_metrics() const {
   return cost_wrapper.cost_based_on_metrics();
 }
 
+bool Vehicle::has_symmetric_costs() const {
+  return cost_wrapper.has_symmetric_costs();
+}
+
 Duration Vehicle::available_duration() const {
   const Duration available = tw.end - tw.start;
 
@@ -98,8 +98,14 @@ struct Vehicle {
 
   bool has_same_profile(const Vehicle& other) const;
 
+  // True iff both vehicles only differ by id, description and
+  // initial steps, so they can be used interchangeably.
+  bool is_equivalent_to(const Vehicle& other) const;
+
   bool cost_based_on_metrics() const;
 
+  bool has_symmetric_costs() const;
+
   Duration available_duration() const;
 
   Cost fixed_cost() const {
@@ -9,6 +9,7 @@ All rights reserved (see LICENSE).
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <numeric>
 #include <sstream>
 
@@ -28,6 +29,94 @@ Amount max_amount(std::size_t size) {
   return max;
 }
 
+Exploration get_auto_exploration(std::size_t nb_jobs,
+                                 std::size_t nb_vehicles,
+                                 unsigned nb_thread,
+                                 const Timeout& timeout) {
+  nb_thread = std::max(1u, nb_thread);
+  const auto max_nb_searches = get_nb_searches(MAX_EXPLORATION_LEVEL);
+
+  if (!timeout.has_value()) {
+    // Keep all threads busy up to the last round of searches.
+    const auto nb_searches = get_nb_searches(DEFAULT_EXPLORATION_LEVEL);
+    const auto nb_rounds = (nb_searches + nb_thread - 1) / nb_thread;
+    const auto nb_auto_searches =
+      std::min(nb_rounds * nb_thread, max_nb_searches);
+    return {nb_auto_searches,
+            get_depth(DEFAULT_EXPLORATION_LEVEL),
+            get_ls_nb_threads(nb_auto_searches, nb_thread)};
+  }
+
+  // Rough duration of a single search on one thread, in milliseconds.
+  // Constants are fitted on single-threaded searches (heuristic and
+  // local search) for random instances with 100 to 400 jobs, 5 to 80
+  // vehicles, depth 0 to 5, with and without time windows, on an Intel
+  // Xeon (Sapphire Rapids) core. A descent grows with the squared
+  // number of jobs times the average route length, while each depth
+  // level adds a cubic term in the number of jobs. Estimates are
+  // within a factor of two of measured durations.
+  const auto jobs = static_cast<double>(nb_jobs);
+  const auto routes =
+    std::clamp(static_cast<double>(nb_vehicles), 1.0, std::max(jobs, 1.0));
+  const auto search_duration = [&](unsigned depth) {
+    constexpr double ms_per_descent_unit = 2.7e-4;
+    constexpr double ms_per_depth_unit = 7.1e-6;
+    return jobs * jobs * jobs *
+           (ms_per_descent_unit / routes + ms_per_depth_unit * depth);
+  };
+
+  // Expected speedup when evaluating moves on ls_nb_threads threads
+  // within a search. On the same instances, move evaluation accounts
+  // for 85% to 98% of a search duration, the remaining part being
+  // heuristic, move application and route updates. This is an upper
+  // bound as it ignores synchronisation and uneven workloads.
+  const auto ls_speedup = [](unsigned ls_nb_threads) {
+    constexpr double evaluation_share = 0.9;
+    return 1 / ((1 - evaluation_share) + evaluation_share / ls_nb_threads);
+  };
+
+  const auto budget = static_cast<double>(timeout.value().count());
+
+  // Most searches expected to complete at given depth, splitting
+  // threads between concurrent searches and move evaluation within
+  // each search. Ties go to more concurrent searches.
+  const auto best_split = [&](unsigned depth) {
+    Exploration best{0, depth, nb_thread};
+    for (unsigned nb_concurrent = nb_thread; nb_concurrent > 0;
+         --nb_concurrent) {
+      const unsigned ls_nb_threads = nb_thread / nb_concurrent;
+      const auto nb_rounds = std::floor(budget * ls_speedup(ls_nb_threads) /
+                                        search_duration(depth));
+      const auto nb_searches = static_cast<unsigned>(
+        std::min(nb_rounds * nb_concurrent,
+                 static_cast<double>(max_nb_searches)));
+      if (nb_searches > best.nb_searches) {
+        best.nb_searches = nb_searches;
+        best.ls_nb_threads = ls_nb_threads;
+      }
+    }
+    return best;
+  };
+
+  // Pick the highest exploration level expected to complete, using
+  // spare rounds for additional searches at the same depth.
+  for (unsigned l = 0; l < MAX_EXPLORATION_LEVEL; ++l) {
+    const unsigned level = MAX_EXPLORATION_LEVEL - l;
+    if (const auto split = best_split(get_depth(level));
+        split.nb_searches >= get_nb_searches(level)) {
+      return split;
+    }
+  }
+
+  // Otherwise run as many searches as expected to complete at the
+  // lowest level, or a single search using all threads if none is.
+  auto split = best_split(get_depth(0));
+  if (split.nb_searches == 0) {
+    split.nb_searches = 1;
+  }
+  return split;
+}
+
 Priority priority_sum_for_route(const Input& input,
                                 const std::vector<Index>& route) {
   return std::accumulate(route.begin(),
@@ -149,13 +238,82 @@ inline std::vector<Job> get_unassigned_jobs_from_ranks(
   const Input& input,
   const std::unordered_set<Index>& unassigned_ranks) {
   std::vector<Job> unassigned_jobs;
-  std::ranges::transform(unassigned_ranks,
-                         std::back_inserter(unassigned_jobs),
-                         [&](auto j) { return input.jobs[j]; });
+  for (const auto j : unassigned_ranks) {
+    if (input.is_aggregated(j)) {
+      std::ranges::transform(input.aggregated_ranks(j),
+                             std::back_inserter(unassigned_jobs),
+                             [&](auto rank) {
+                               return input.unaggregated_job(rank);
+                             });
+    } else {
+      unassigned_jobs.push_back(input.jobs[j]);
+    }
+  }
 
   return unassigned_jobs;
 }
 
+// Replace steps for aggregated jobs with steps for the original jobs,
+// served in a row at the same location in the order from
+// Input::aggregated_ranks.
+inline void expand_aggregated_jobs(const Input& input,
+                                   std::vector<Route>& routes) {
+  const auto is_aggregated_step = [&](const Step& step) {
+    return step.job_type == JOB_TYPE::SINGLE &&
+           input.is_aggregated(input.job_id_to_rank.at(step.id));
+  };
+
+  for (auto& route : routes) {
+    if (std::ranges::none_of(route.steps, is_aggregated_step)) {
+      continue;
+    }
+
+    const auto& v =
+      *std::ranges::find(input.vehicles, route.vehicle, &Vehicle::id);
+
+    std::vector<Step> steps;
+    steps.reserve(route.steps.size());
+
+    for (auto& step : route.steps) {
+      if (!is_aggregated_step(step)) {
+        steps.push_back(std::move(step));
+        continue;
+      }
+
+      const auto rank = input.job_id_to_rank.at(step.id);
+      const auto& job = input.jobs[rank];
+      Amount load = step.load;
+      load -= job.pickup;
+      load += job.delivery;
+
+      auto arrival = step.arrival;
+      bool first = true;
+      for (const auto member_rank : input.aggregated_ranks(rank)) {
+        const auto& member = input.unaggregated_job(member_rank);
+        load += member.pickup;
+        load -= member.delivery;
+
+        steps.emplace_back(member,
+                           first ? step.setup : 0,
+                           scale_to_user_duration(member.services[v.type]),
+                           load);
+        auto& current = steps.back();
+        current.arrival = arrival;
+        current.duration = step.duration;
+        current.distance = step.distance;
+        current.violations = step.violations;
+        if (first) {
+          current.waiting_time = step.waiting_time;
+          first = false;
+        }
+        arrival = current.departure();
+      }
+    }
+
+    route.steps = std::move(steps);
+  }
+}
+
 Solution format_solution(const Input& input, const RawSolution& raw_routes) {
   std::vector<Route> routes;
   routes.reserve(raw_routes.size());
@@ -318,6 +476,8 @@ Solution format_solution(const Input& input, const RawSolution& raw_routes) {
                         v.description);
   }
 
+  expand_aggregated_jobs(input, routes);
+
   return Solution(input.zero_amount(),
                   std::move(routes),
                   get_unassigned_jobs_from_ranks(input, unassigned_ranks));
@@ -825,6 +985,8 @@ Solution format_solution(const Input& input, const TWSolution& tw_routes) {
     }
   }
 
+  expand_aggregated_jobs(input, routes);
+
   return Solution(input.zero_amount(),
                   std::move(routes),
                   get_unassigned_jobs_from_ranks(input, unassigned_ranks));
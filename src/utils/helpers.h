@@ -10,9 +10,16 @@ All rights reserved (see LICENSE).
 
 */
 
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "structures/typedefs.h"
@@ -52,6 +59,41 @@ inline uint32_t get_vector_hash(const std::vector<uint32_t>& vec) {
   return seed;
 }
 
+// Same mixing as boost::hash_combine.
+template <typename T> inline void hash_combine(std::size_t& seed, const T& v) {
+  seed ^= std::hash<T>()(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+// Append the raw bytes of v to key. Strings are prefixed with their
+// size and optional values with a presence flag, so that distinct
+// sequences of values always yield distinct keys.
+template <typename T> inline void append_to_key(std::string& key, const T& v) {
+  if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    const std::string_view str = v;
+    append_to_key(key, str.size());
+    key.append(str);
+  } else {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+    key.append(reinterpret_cast<const char*>(&v), sizeof(T));
+  }
+}
+
+template <typename T>
+inline void append_to_key(std::string& key, const std::optional<T>& v) {
+  append_to_key(key, v.has_value());
+  if (v.has_value()) {
+    append_to_key(key, v.value());
+  }
+}
+
+// Choose the number of searches, depth and threads split so that all
+// searches are expected to complete within timeout using nb_thread
+// threads.
+Exploration get_auto_exploration(std::size_t nb_jobs,
+                                 std::size_t nb_vehicles,
+                                 unsigned nb_thread,
+                                 const Timeout& timeout);
+
 inline unsigned get_depth(unsigned exploration_level) {
   return exploration_level;
 }
@@ -70,6 +112,59 @@ inline unsigned get_nb_searches(unsigned exploration_level) {
   return nb_searches;
 }
 
+// Default threads split: threads not used to run searches
+// concurrently are used to evaluate moves in parallel within each
+// local search. No more searches than for the max exploration level
+// are ever run.
+inline unsigned get_ls_nb_threads(unsigned nb_searches, unsigned nb_thread) {
+  nb_thread = std::max(1u, nb_thread);
+  const auto max_nb_searches = get_nb_searches(MAX_EXPLORATION_LEVEL);
+  return nb_thread / std::clamp(nb_searches,
+                                1u,
+                                std::min(max_nb_searches, nb_thread));
+}
+
+// Split [0, size) into consecutive ranges and run f(begin, end) on
+// each range using up to nb_thread threads. Any exception is rethrown
+// once all threads are done.
+template <class F>
+void run_on_ranges(unsigned nb_thread, std::size_t size, const F& f) {
+  const auto nb_ranges = static_cast<unsigned>(
+    std::min<std::size_t>(size, std::max(1u, nb_thread)));
+
+  if (nb_ranges <= 1) {
+    f(0, size);
+    return;
+  }
+
+  std::exception_ptr ep = nullptr;
+  std::mutex ep_m;
+
+  auto run_on_range = [&](unsigned rank) {
+    try {
+      f(rank * size / nb_ranges, (rank + 1) * size / nb_ranges);
+    } catch (...) {
+      const std::scoped_lock<std::mutex> lock(ep_m);
+      ep = std::current_exception();
+    }
+  };
+
+  std::vector<std::jthread> threads;
+  threads.reserve(nb_ranges);
+
+  for (unsigned rank = 0; rank < nb_ranges; ++rank) {
+    threads.emplace_back(run_on_range, rank);
+  }
+
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  if (ep != nullptr) {
+    std::rethrow_exception(ep);
+  }
+}
+
 // Evaluate adding job with rank job_rank in given route at given rank
 // for vehicle v.
 inline Eval addition_eval(const Input& input,
@@ -260,15 +355,18 @@ inline Eval get_range_removal_gain(const SolutionState& sol_state,
   Eval removal_gain;
 
   if (last_rank > first_rank) {
+    const auto& evals =
+      sol_state.class_evals(v, sol_state.vehicle_class(v));
+
     // Gain related to removed portion.
-    removal_gain += sol_state.fwd_evals[v][v][last_rank - 1];
-    removal_gain -= sol_state.fwd_evals[v][v][first_rank];
+    removal_gain += evals.fwd[last_rank - 1];
+    removal_gain -= evals.fwd[first_rank];
 
-    removal_gain += sol_state.fwd_setup_evals[v][v][last_rank - 1];
-    removal_gain += sol_state.service_evals[v][v][last_rank - 1];
+    removal_gain += evals.fwd_setup[last_rank - 1];
+    removal_gain += evals.service[last_rank - 1];
     if (first_rank > 0) {
-      removal_gain -= sol_state.fwd_setup_evals[v][v][first_rank - 1];
-      removal_gain -= sol_state.service_evals[v][v][first_rank - 1];
+      removal_gain -= evals.fwd_setup[first_rank - 1];
+      removal_gain -= evals.service[first_rank - 1];
     }
   }
 
@@ -298,40 +396,38 @@ addition_eval_delta(const Input& input,
   const auto& r2 = route_2.route;
   const auto v2_rank = route_2.v_rank;
   const auto& v1 = input.vehicles[v1_rank];
+  const auto v1_class = input.vehicle_class(v1_rank);
 
   // Common part of the cost.
   Eval cost_delta =
     get_range_removal_gain(sol_state, v1_rank, first_rank, last_rank);
 
+  // Evals for route_2 from the point of view of vehicle for route_1.
+  const auto& r2_evals = sol_state.class_evals(v2_rank, v1_class);
+
   // Tasks service eval.
-  Eval service_delta =
-    -sol_state.service_evals[v2_rank][v1_rank][insertion_end - 1];
+  Eval service_delta = -r2_evals.service[insertion_end - 1];
   if (insertion_start > 0) {
-    service_delta +=
-      sol_state.service_evals[v2_rank][v1_rank][insertion_start - 1];
+    service_delta += r2_evals.service[insertion_start - 1];
   }
 
   // Part of the cost that may depend on insertion orientation.
 
   // Edges cost eval.
-  Eval straight_delta = sol_state.fwd_evals[v2_rank][v1_rank][insertion_start];
-  straight_delta -= sol_state.fwd_evals[v2_rank][v1_rank][insertion_end - 1];
+  Eval straight_delta = r2_evals.fwd[insertion_start];
+  straight_delta -= r2_evals.fwd[insertion_end - 1];
 
-  Eval reversed_delta = sol_state.bwd_evals[v2_rank][v1_rank][insertion_start];
-  reversed_delta -= sol_state.bwd_evals[v2_rank][v1_rank][insertion_end - 1];
+  Eval reversed_delta = r2_evals.bwd[insertion_start];
+  reversed_delta -= r2_evals.bwd[insertion_end - 1];
 
   // Tasks setup eval, this purposefully does not include setup time
   // for the first job in the previous route context (using
   // insertion_start, not the previous rank).
-  straight_delta -=
-    sol_state.fwd_setup_evals[v2_rank][v1_rank][insertion_end - 1];
-  straight_delta +=
-    sol_state.fwd_setup_evals[v2_rank][v1_rank][insertion_start];
-
-  reversed_delta -=
-    sol_state.bwd_setup_evals[v2_rank][v1_rank][insertion_start];
-  reversed_delta +=
-    sol_state.bwd_setup_evals[v2_rank][v1_rank][insertion_end - 1];
+  straight_delta -= r2_evals.fwd_setup[insertion_end - 1];
+  straight_delta += r2_evals.fwd_setup[insertion_start];
+
+  reversed_delta -= r2_evals.bwd_setup[insertion_start];
+  reversed_delta += r2_evals.bwd_setup[insertion_end - 1];
 
   // Determine useful values if present.
   const auto [before_first, first_index, last_index] =
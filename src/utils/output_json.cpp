@@ -196,6 +196,20 @@ rapidjson::Value to_json(const Summary& summary,
                          to_json(summary.computing_times, allocator),
                          allocator);
 
+  if (summary.exploration.has_value()) {
+    rapidjson::Value json_exploration(rapidjson::kObjectType);
+    json_exploration.AddMember("searches",
+                               summary.exploration.value().nb_searches,
+                               allocator);
+    json_exploration.AddMember("depth",
+                               summary.exploration.value().depth,
+                               allocator);
+    json_exploration.AddMember("search_threads",
+                               summary.exploration.value().ls_nb_threads,
+                               allocator);
+    json_summary.AddMember("exploration", json_exploration, allocator);
+  }
+
   return json_summary;
 }
 